@@ -0,0 +1,323 @@
+// publisher_bench.cpp
+//
+// Micro-benchmarks for the publish hot path: buffering, serialization,
+// transmission, command execution, config placeholder replacement and the
+// MidasEventProcessor output path.
+//
+// Results are written as JSON to publisher_bench.json (override with
+// --benchmark_out=<file>) so runs can be compared with Google Benchmark's
+// tools/compare.py.
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <zmq.hpp>
+#include "command_management/CommandRunner.h"
+#include "data_transmitter/DataBuffer.h"
+#include "data_transmitter/DataChannel.h"
+#include "data_transmitter/DataTransmitter.h"
+#include "data_transmitter/DataTransmitterManager.h"
+#include "processors/MidasEventProcessor.h"
+#include "receivers/MidasReceiverProvider.h"
+#include "utilities/JsonManager.h"
+#include "utilities/JsonWriter.h"
+
+using json = nlohmann::json;
+
+namespace {
+
+const char* DEFAULT_CONFIG_FILE = "config/config.json";
+
+/**
+ * @brief Builds a JSON-looking payload of roughly the given size, so string escaping is exercised.
+ */
+std::string makePayload(size_t bytes) {
+    std::string payload = "{\"data\":\"";
+    payload.append(bytes > payload.size() + 2 ? bytes - payload.size() - 2 : 0, 'x');
+    payload += "\"}";
+    return payload;
+}
+
+/**
+ * @brief Drains a SUB socket on its own thread so the publisher is measured against a live peer.
+ */
+class Subscriber {
+public:
+    Subscriber(zmq::context_t& context, const std::string& address)
+        : running_(true), connected_(false), received_(0) {
+        thread_ = std::thread([this, &context, address] {
+            zmq::socket_t socket(context, ZMQ_SUB);
+            socket.set(zmq::sockopt::subscribe, "");
+            socket.set(zmq::sockopt::rcvtimeo, 50);
+            socket.connect(address);
+            connected_ = true;
+
+            zmq::message_t message;
+            while (running_.load()) {
+                if (socket.recv(message)) {
+                    received_++;
+                }
+            }
+        });
+
+        while (!connected_.load()) {
+            std::this_thread::yield();
+        }
+        // Give the subscription time to reach the publisher
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    ~Subscriber() {
+        stop();
+    }
+
+    uint64_t stop() {
+        running_ = false;
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        return received_.load();
+    }
+
+private:
+    std::atomic<bool> running_;
+    std::atomic<bool> connected_;
+    std::atomic<uint64_t> received_; ///< Frames received (topic and payload counted separately).
+    std::thread thread_;
+};
+
+// ------------------------------------------------------------------------------
+// DataBuffer
+// ------------------------------------------------------------------------------
+
+// The first argument is the number of entries kept. A DataBuffer holds one entry fewer
+// than its size, so it is sized as DataChannelManager does: num-events-in-circular-buffer + 1.
+
+void BM_DataBufferPush(benchmark::State& state) {
+    DataBuffer<std::string> buffer(state.range(0) + 1);
+    const std::string payload = makePayload(state.range(1));
+
+    for (auto _ : state) {
+        std::string entry = payload;
+        buffer.Push(std::move(entry));
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * payload.size());
+}
+BENCHMARK(BM_DataBufferPush)->ArgsProduct({{1, 16, 256}, {64, 4096, 262144}});
+
+void BM_DataBufferGetBuffer(benchmark::State& state) {
+    DataBuffer<std::string> buffer(state.range(0) + 1);
+    const std::string payload = makePayload(state.range(1));
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        buffer.Push(payload);
+    }
+
+    for (auto _ : state) {
+        auto events = buffer.GetBuffer();
+        benchmark::DoNotOptimize(events.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DataBufferGetBuffer)->ArgsProduct({{1, 16, 256}, {64, 4096, 262144}});
+
+void BM_DataBufferSerializeBuffer(benchmark::State& state) {
+    DataBuffer<std::string> buffer(state.range(0) + 1);
+    const std::string payload = makePayload(state.range(1));
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        buffer.Push(payload);
+    }
+
+    JsonWriter writer;
+    size_t bytes = 0;
+    for (auto _ : state) {
+        writer.clear();
+        buffer.SerializeBuffer(writer);
+        bytes += writer.size();
+        benchmark::DoNotOptimize(writer.str().data());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_DataBufferSerializeBuffer)->ArgsProduct({{1, 16, 256}, {64, 4096, 262144}});
+
+// ------------------------------------------------------------------------------
+// DataTransmitter
+// ------------------------------------------------------------------------------
+
+void BM_DataTransmitterPublish(benchmark::State& state, const std::string& address) {
+    auto transmitter = DataTransmitterManager::Instance().getTransmitter(address);
+    if (!transmitter->isBound() && !transmitter->bind()) {
+        state.SkipWithError("Failed to bind");
+        return;
+    }
+    Subscriber subscriber(transmitter->getContext(), address);
+
+    DataChannel channel("BENCH", 1, 0);
+    const std::string payload = makePayload(state.range(0));
+
+    for (auto _ : state) {
+        std::string data = payload;
+        transmitter->publish(channel, std::move(data));
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * payload.size());
+    state.counters["frames_received"] = static_cast<double>(subscriber.stop());
+}
+BENCHMARK_CAPTURE(BM_DataTransmitterPublish, inproc, std::string("inproc://publisher_bench"))
+    ->Arg(64)->Arg(4096)->Arg(262144);
+BENCHMARK_CAPTURE(BM_DataTransmitterPublish, ipc, std::string("ipc:///tmp/publisher_bench.ipc"))
+    ->Arg(64)->Arg(4096)->Arg(262144);
+
+// ------------------------------------------------------------------------------
+// CommandRunner
+// ------------------------------------------------------------------------------
+
+void BM_CommandRunnerExecute(benchmark::State& state, bool shell) {
+    std::string bytesArg = std::to_string(state.range(0));
+    // The pipe forces /bin/sh; the argument vector is spawned directly
+    CommandRunner runner = shell ? CommandRunner("yes publisher_bench | head -c " + bytesArg)
+                                 : CommandRunner(std::vector<std::string>{"head", "-c", bytesArg, "/dev/zero"});
+
+    size_t bytes = 0;
+    for (auto _ : state) {
+        const std::string& output = runner.execute();
+        bytes += output.size();
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK_CAPTURE(BM_CommandRunnerExecute, shell, true)
+    ->Arg(16)->Arg(65536)->Arg(1 << 20)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_CommandRunnerExecute, argv, false)
+    ->Arg(16)->Arg(65536)->Arg(1 << 20)->Unit(benchmark::kMicrosecond);
+
+// ------------------------------------------------------------------------------
+// JsonManager
+// ------------------------------------------------------------------------------
+
+void BM_JsonManagerReplaceEnvironmentVariables(benchmark::State& state) {
+    setenv("PUBLISHER_BENCH_DIR", "/opt/publisher", 1);
+
+    // A config shaped like the real one: channels with nested processors and a few paths
+    json config = {{"data-channels", json::object()}};
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        config["data-channels"]["channel-" + std::to_string(i)] = {
+            {"zmq-address", "tcp://127.0.0.1:5555"},
+            {"name", "CHANNEL"},
+            {"processors", {{
+                {"processor", "CommandProcessor"},
+                {"command", "$(PUBLISHER_BENCH_DIR)/bin/status --channel " + std::to_string(i)},
+                {"plugin_libraries", {"$(PUBLISHER_BENCH_DIR)/lib/a.so", "$(PUBLISHER_BENCH_DIR)/lib/b.so"}},
+                {"period-ms", 1000}
+            }}}
+        };
+    }
+
+    for (auto _ : state) {
+        json replaced = JsonManager::replaceEnvironmentVariables(config);
+        benchmark::DoNotOptimize(replaced);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_JsonManagerReplaceEnvironmentVariables)->Arg(1)->Arg(16)->Arg(256);
+
+// ------------------------------------------------------------------------------
+// MidasEventProcessor
+// ------------------------------------------------------------------------------
+
+/**
+ * @brief Finds the first MidasEventProcessor pipeline config in the publisher config.
+ */
+json loadPipelineConfig() {
+    const char* configFile = std::getenv("PUBLISHER_BENCH_CONFIG");
+    std::ifstream stream(configFile ? configFile : DEFAULT_CONFIG_FILE);
+    if (!stream) {
+        return json();
+    }
+
+    json config = JsonManager::replaceEnvironmentVariables(json::parse(stream));
+    for (const auto& [channelName, channel] : config.value("data-channels", json::object()).items()) {
+        for (const auto& processor : channel.value("processors", json::array())) {
+            if (processor.value("processor", "") == "MidasEventProcessor" && processor.contains("pipeline_config")) {
+                return processor["pipeline_config"];
+            }
+        }
+    }
+    return json();
+}
+
+void BM_MidasEventProcessorOutput(benchmark::State& state) {
+    json pipelineConfig = loadPipelineConfig();
+    if (!pipelineConfig.is_object()) {
+        state.SkipWithError("No MidasEventProcessor pipeline_config found (run from the repository root)");
+        return;
+    }
+
+    json receiverConfig = {{"num-events-per-retrieval", 1}};
+    json processorConfig = {
+        {"event-source", {
+            {"type", "synthetic"},
+            {"rate-hz", 0},
+            {"num-banks", state.range(0)},
+            {"bank-size-bytes", state.range(1)}
+        }}
+    };
+
+    MidasEventProcessor processor;
+    try {
+        processor.Init(receiverConfig, pipelineConfig, processorConfig);
+    } catch (const std::exception& e) {
+        state.SkipWithError(e.what());
+        return;
+    }
+
+    size_t bytes = 0;
+    for (auto _ : state) {
+        auto output = processor.getProcessedOutput();
+        for (const auto& message : output) {
+            bytes += message.size();
+        }
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_MidasEventProcessorOutput)->ArgsProduct({{1, 8}, {256, 16384}})->Unit(benchmark::kMicrosecond);
+
+} // namespace
+
+int main(int argc, char** argv) {
+    spdlog::set_level(spdlog::level::warn);
+
+    // Never touch a real experiment from a benchmark
+    MidasReceiverProvider::Instance().configure(json{{"type", "fake"}});
+
+    std::vector<char*> args(argv, argv + argc);
+    bool hasOutput = false;
+    for (const char* arg : args) {
+        hasOutput = hasOutput || std::string(arg).rfind("--benchmark_out=", 0) == 0;
+    }
+    std::string outputArg = "--benchmark_out=publisher_bench.json";
+    std::string formatArg = "--benchmark_out_format=json";
+    if (!hasOutput) {
+        args.push_back(outputArg.data());
+        args.push_back(formatArg.data());
+    }
+
+    int count = static_cast<int>(args.size());
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data())) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
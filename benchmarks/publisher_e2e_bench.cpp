@@ -0,0 +1,446 @@
+// publisher_e2e_bench.cpp
+//
+// End-to-end throughput and latency harness. Starts the publisher with a generated
+// configuration (fake MIDAS receiver fed by the synthetic event source), attaches
+// local SUB clients over tcp or ipc and reports, per channel, the sustained
+// message and byte rates and the p50/p99/p99.9 latency from event arrival at the
+// receiver ("source_time_ns", see stamp-source-time) to receipt by the subscriber.
+//
+// Run from the repository root so the pipeline plugin paths resolve:
+//   ./build/bin/publisher_e2e_bench --channels 2 --subscribers 2 --rate-hz 5000
+// Pass --help for all options.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <nlohmann/json.hpp>
+#include <zmq.hpp>
+#include "utilities/JsonManager.h"
+
+using json = nlohmann::json;
+
+namespace {
+
+const char* DEFAULT_CONFIG_FILE = "config/config.json";
+const char* STAMP_KEY = "source_time_ns";
+
+/**
+ * @brief Harness options, all settable as --<name> <value>.
+ */
+struct Options {
+    std::string publisher;              ///< Publisher executable (default: next to this tool).
+    std::string pipelineConfigFile = DEFAULT_CONFIG_FILE; ///< Config to take the MidasEventProcessor pipeline from.
+    std::string transport = "tcp";      ///< tcp or ipc.
+    std::string output = "publisher_e2e_bench.json"; ///< JSON report path.
+    int channels = 1;                   ///< Number of data channels.
+    int subscribers = 1;                ///< Number of SUB clients, each subscribed to every channel.
+    int basePort = 15555;               ///< First tcp port.
+    double warmupSeconds = 2.0;         ///< Time ignored at start.
+    double durationSeconds = 10.0;      ///< Measured time.
+    double rateHz = 1000.0;             ///< Synthetic event rate.
+    int numBanks = 4;                   ///< Banks per synthetic event.
+    int bankSizeBytes = 1024;           ///< Bytes per bank.
+    int receiverBufferSize = 1000;      ///< Fake receiver buffer.
+    int periodMs = 1;                   ///< Processor period-ms.
+    int publishesPerBatch = 1;          ///< Channel publishes-per-batch.
+    int publishesIgnoredAfterBatch = 0; ///< Channel publishes-ignored-after-batch.
+    int bufferSize = 1;                 ///< Channel num-events-in-circular-buffer.
+    int eventsPerRetrieval = 1;         ///< num-events-per-retrieval.
+};
+
+/**
+ * @brief What one subscriber saw on one channel.
+ */
+struct ChannelStats {
+    uint64_t messages = 0;
+    uint64_t bytes = 0;
+    std::vector<int64_t> latenciesNs;
+    int64_t lastStampNs = 0; ///< Newest stamp counted so far; older ones are buffer entries sent again.
+};
+
+void printHelp() {
+    std::printf(
+        "Usage: publisher_e2e_bench [OPTIONS]\n\n"
+        "  --publisher <path>          publisher executable (default: next to this tool)\n"
+        "  --pipeline-config <file>    config providing the MidasEventProcessor pipeline_config (default: %s)\n"
+        "  --transport tcp|ipc         transport between publisher and subscribers (default: tcp)\n"
+        "  --channels <n>              data channels (default: 1)\n"
+        "  --subscribers <n>           SUB clients, each on every channel (default: 1)\n"
+        "  --base-port <n>             first tcp port (default: 15555)\n"
+        "  --warmup-s <s>              seconds ignored at start (default: 2)\n"
+        "  --duration-s <s>            measured seconds (default: 10)\n"
+        "  --rate-hz <hz>              synthetic event rate, 0 for unpaced (default: 1000)\n"
+        "  --num-banks <n>             banks per event (default: 4)\n"
+        "  --bank-size-bytes <n>       bytes per bank (default: 1024)\n"
+        "  --receiver-buffer-size <n>  fake receiver buffer (default: 1000)\n"
+        "  --period-ms <ms>            processor period-ms (default: 1)\n"
+        "  --publishes-per-batch <n>   channel publishes-per-batch (default: 1)\n"
+        "  --publishes-ignored-after-batch <n>  (default: 0)\n"
+        "  --buffer-size <n>           channel num-events-in-circular-buffer (default: 1)\n"
+        "  --events-per-retrieval <n>  num-events-per-retrieval (default: 1)\n"
+        "  --output <file>             JSON report (default: publisher_e2e_bench.json)\n",
+        DEFAULT_CONFIG_FILE);
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            printHelp();
+            std::exit(0);
+        }
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "Missing value for %s\n", arg.c_str());
+            return false;
+        }
+        std::string value = argv[++i];
+
+        if (arg == "--publisher") options.publisher = value;
+        else if (arg == "--pipeline-config") options.pipelineConfigFile = value;
+        else if (arg == "--transport") options.transport = value;
+        else if (arg == "--output") options.output = value;
+        else if (arg == "--channels") options.channels = std::stoi(value);
+        else if (arg == "--subscribers") options.subscribers = std::stoi(value);
+        else if (arg == "--base-port") options.basePort = std::stoi(value);
+        else if (arg == "--warmup-s") options.warmupSeconds = std::stod(value);
+        else if (arg == "--duration-s") options.durationSeconds = std::stod(value);
+        else if (arg == "--rate-hz") options.rateHz = std::stod(value);
+        else if (arg == "--num-banks") options.numBanks = std::stoi(value);
+        else if (arg == "--bank-size-bytes") options.bankSizeBytes = std::stoi(value);
+        else if (arg == "--receiver-buffer-size") options.receiverBufferSize = std::stoi(value);
+        else if (arg == "--period-ms") options.periodMs = std::stoi(value);
+        else if (arg == "--publishes-per-batch") options.publishesPerBatch = std::stoi(value);
+        else if (arg == "--publishes-ignored-after-batch") options.publishesIgnoredAfterBatch = std::stoi(value);
+        else if (arg == "--buffer-size") options.bufferSize = std::stoi(value);
+        else if (arg == "--events-per-retrieval") options.eventsPerRetrieval = std::stoi(value);
+        else {
+            std::fprintf(stderr, "Unknown option %s\n", arg.c_str());
+            return false;
+        }
+    }
+
+    if (options.transport != "tcp" && options.transport != "ipc") {
+        std::fprintf(stderr, "Transport must be tcp or ipc\n");
+        return false;
+    }
+    if (options.channels < 1 || options.subscribers < 1) {
+        std::fprintf(stderr, "Need at least one channel and one subscriber\n");
+        return false;
+    }
+    if (options.publisher.empty()) {
+        options.publisher = (std::filesystem::read_symlink("/proc/self/exe").parent_path() / "publisher").string();
+    }
+    return true;
+}
+
+std::string channelAddress(const Options& options, int index) {
+    if (options.transport == "ipc") {
+        return "ipc:///tmp/publisher_e2e_bench_" + std::to_string(getpid()) + "_" + std::to_string(index) + ".ipc";
+    }
+    return "tcp://127.0.0.1:" + std::to_string(options.basePort + index);
+}
+
+std::string channelName(int index) {
+    return "E2E" + std::to_string(index);
+}
+
+json loadPipelineConfig(const std::string& configFile) {
+    std::ifstream stream(configFile);
+    if (!stream) {
+        return json();
+    }
+
+    json config = JsonManager::replaceEnvironmentVariables(json::parse(stream));
+    for (const auto& [name, channel] : config.value("data-channels", json::object()).items()) {
+        for (const auto& processor : channel.value("processors", json::array())) {
+            if (processor.value("processor", "") == "MidasEventProcessor" && processor.contains("pipeline_config")) {
+                return processor["pipeline_config"];
+            }
+        }
+    }
+    return json();
+}
+
+json makePublisherConfig(const Options& options, const json& pipelineConfig) {
+    json config;
+    config["general-settings"] = {
+        {"verbose", 0},
+        {"midas-receiver", {
+            {"type", "fake"},
+            {"buffer-size", options.receiverBufferSize},
+            {"events", {
+                {"type", "synthetic"},
+                {"rate-hz", options.rateHz},
+                {"num-banks", options.numBanks},
+                {"bank-size-bytes", options.bankSizeBytes}
+            }}
+        }},
+        {"recording", {{"enabled", false}}}
+    };
+
+    config["data-channels"] = json::object();
+    for (int i = 0; i < options.channels; ++i) {
+        config["data-channels"]["e2e-channel-" + std::to_string(i)] = {
+            {"enabled", true},
+            {"zmq-address", channelAddress(options, i)},
+            {"name", channelName(i)},
+            {"publishes-per-batch", options.publishesPerBatch},
+            {"publishes-ignored-after-batch", options.publishesIgnoredAfterBatch},
+            {"num-events-in-circular-buffer", options.bufferSize},
+            {"processors", {{
+                {"processor", "MidasEventProcessor"},
+                {"period-ms", options.periodMs},
+                {"midas_event_processor_config", {
+                    {"stamp-source-time", true},
+                    {"event-source", {{"type", "live"}}}
+                }},
+                {"midas_receiver_config", {{"num-events-per-retrieval", options.eventsPerRetrieval}}},
+                {"pipeline_config", pipelineConfig}
+            }}}
+        };
+    }
+    return config;
+}
+
+/**
+ * @brief Appends every new source stamp found in a payload to the channel's latency list.
+ *
+ * The payload is a JSON array of escaped event envelopes, so the stamps are found
+ * by scanning rather than by parsing the whole message twice. A channel with a
+ * buffer larger than one entry sends each event again in later messages, so only
+ * stamps newer than any in the channel's previous messages are counted.
+ */
+void collectLatencies(const char* data, size_t size, int64_t receivedNs, ChannelStats& channel) {
+    const char* end = data + size;
+    int64_t newestNs = channel.lastStampNs;
+    const size_t keyLength = std::strlen(STAMP_KEY);
+    const char* cursor = data;
+
+    while (true) {
+        const char* found = std::search(cursor, end, STAMP_KEY, STAMP_KEY + keyLength);
+        if (found == end) {
+            channel.lastStampNs = newestNs;
+            return;
+        }
+        cursor = found + keyLength;
+        while (cursor < end && (*cursor == '\\' || *cursor == '"' || *cursor == ':' || *cursor == ' ')) {
+            ++cursor;
+        }
+
+        int64_t stamp = 0;
+        bool hasDigits = false;
+        while (cursor < end && *cursor >= '0' && *cursor <= '9') {
+            stamp = stamp * 10 + (*cursor - '0');
+            hasDigits = true;
+            ++cursor;
+        }
+        if (hasDigits && stamp > channel.lastStampNs) {
+            channel.latenciesNs.push_back(receivedNs - stamp);
+            newestNs = std::max(newestNs, stamp);
+        }
+    }
+}
+
+void subscriberLoop(zmq::context_t& context, const std::vector<std::string>& addresses,
+                    const std::atomic<bool>& running, std::chrono::steady_clock::time_point measureStart,
+                    std::map<std::string, ChannelStats>& stats) {
+    zmq::socket_t socket(context, ZMQ_SUB);
+    socket.set(zmq::sockopt::subscribe, "");
+    socket.set(zmq::sockopt::rcvtimeo, 100);
+    socket.set(zmq::sockopt::rcvhwm, 0);
+    for (const auto& address : addresses) {
+        socket.connect(address);
+    }
+
+    zmq::message_t first;
+    zmq::message_t payload;
+    while (running.load()) {
+        if (!socket.recv(first)) {
+            continue;
+        }
+
+        // Named channels send a topic frame first
+        std::string topic;
+        zmq::message_t* body = &first;
+        if (first.more()) {
+            topic = first.to_string();
+            if (!socket.recv(payload)) {
+                continue;
+            }
+            body = &payload;
+        }
+        int64_t receivedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+
+        if (std::chrono::steady_clock::now() < measureStart) {
+            continue;
+        }
+
+        ChannelStats& channel = stats[topic];
+        channel.messages++;
+        channel.bytes += body->size();
+        collectLatencies(static_cast<const char*>(body->data()), body->size(), receivedNs, channel);
+    }
+}
+
+double percentileUs(const std::vector<int64_t>& sortedNs, double fraction) {
+    if (sortedNs.empty()) {
+        return 0.0;
+    }
+    size_t rank = static_cast<size_t>(std::ceil(fraction * sortedNs.size()));
+    size_t index = std::min(sortedNs.size() - 1, rank > 0 ? rank - 1 : 0);
+    return sortedNs[index] / 1000.0;
+}
+
+pid_t startPublisher(const std::string& publisher, const std::string& configFile) {
+    pid_t pid = fork();
+    if (pid == 0) {
+        execl(publisher.c_str(), publisher.c_str(), "--config", configFile.c_str(), static_cast<char*>(nullptr));
+        std::perror("execl");
+        _exit(127);
+    }
+    return pid;
+}
+
+void stopPublisher(pid_t pid) {
+    kill(pid, SIGINT);
+    for (int i = 0; i < 50; ++i) {
+        if (waitpid(pid, nullptr, WNOHANG) == pid) {
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    std::fprintf(stderr, "Publisher did not exit after SIGINT, killing it\n");
+    kill(pid, SIGKILL);
+    waitpid(pid, nullptr, 0);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printHelp();
+        return 1;
+    }
+
+    json pipelineConfig = loadPipelineConfig(options.pipelineConfigFile);
+    if (!pipelineConfig.is_object()) {
+        std::fprintf(stderr, "No MidasEventProcessor pipeline_config found in %s\n", options.pipelineConfigFile.c_str());
+        return 1;
+    }
+
+    std::string configFile = (std::filesystem::temp_directory_path() /
+                              ("publisher_e2e_bench_" + std::to_string(getpid()) + ".json")).string();
+    {
+        std::ofstream stream(configFile);
+        stream << makePublisherConfig(options, pipelineConfig).dump(2);
+    }
+
+    std::vector<std::string> addresses;
+    for (int i = 0; i < options.channels; ++i) {
+        addresses.push_back(channelAddress(options, i));
+    }
+
+    // Subscribers first: they reconnect until the publisher binds
+    zmq::context_t context(1);
+    std::atomic<bool> running(true);
+    auto measureStart = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(options.warmupSeconds));
+    std::vector<std::map<std::string, ChannelStats>> subscriberStats(options.subscribers);
+    std::vector<std::thread> subscribers;
+    for (int i = 0; i < options.subscribers; ++i) {
+        subscribers.emplace_back(subscriberLoop, std::ref(context), std::cref(addresses), std::cref(running),
+                                 measureStart, std::ref(subscriberStats[i]));
+    }
+
+    pid_t publisher = startPublisher(options.publisher, configFile);
+    if (publisher < 0) {
+        std::perror("fork");
+        running = false;
+        for (auto& thread : subscribers) thread.join();
+        return 1;
+    }
+
+    std::this_thread::sleep_until(measureStart);
+    auto measuredFrom = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::duration<double>(options.durationSeconds));
+    double measuredSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - measuredFrom).count();
+
+    running = false;
+    for (auto& thread : subscribers) {
+        thread.join();
+    }
+    stopPublisher(publisher);
+    std::filesystem::remove(configFile);
+
+    // Rates are per subscriber; latencies are pooled over subscribers
+    json report = {
+        {"settings", {
+            {"transport", options.transport},
+            {"channels", options.channels},
+            {"subscribers", options.subscribers},
+            {"duration_s", measuredSeconds},
+            {"rate_hz", options.rateHz},
+            {"num_banks", options.numBanks},
+            {"bank_size_bytes", options.bankSizeBytes},
+            {"receiver_buffer_size", options.receiverBufferSize},
+            {"period_ms", options.periodMs},
+            {"publishes_per_batch", options.publishesPerBatch},
+            {"publishes_ignored_after_batch", options.publishesIgnoredAfterBatch},
+            {"buffer_size", options.bufferSize},
+            {"events_per_retrieval", options.eventsPerRetrieval}
+        }},
+        {"channels", json::object()}
+    };
+
+    std::printf("%-10s %12s %14s %10s %10s %10s %10s\n",
+                "channel", "msgs/s", "bytes/s", "events", "p50 us", "p99 us", "p99.9 us");
+    for (int i = 0; i < options.channels; ++i) {
+        std::string name = channelName(i);
+        ChannelStats total;
+        for (auto& stats : subscriberStats) {
+            auto it = stats.find(name);
+            if (it == stats.end()) continue;
+            total.messages += it->second.messages;
+            total.bytes += it->second.bytes;
+            total.latenciesNs.insert(total.latenciesNs.end(), it->second.latenciesNs.begin(), it->second.latenciesNs.end());
+        }
+        std::sort(total.latenciesNs.begin(), total.latenciesNs.end());
+
+        double messagesPerSecond = total.messages / measuredSeconds / options.subscribers;
+        double bytesPerSecond = total.bytes / measuredSeconds / options.subscribers;
+        double p50 = percentileUs(total.latenciesNs, 0.50);
+        double p99 = percentileUs(total.latenciesNs, 0.99);
+        double p999 = percentileUs(total.latenciesNs, 0.999);
+        double maxUs = total.latenciesNs.empty() ? 0.0 : total.latenciesNs.back() / 1000.0;
+
+        report["channels"][name] = {
+            {"messages", total.messages},
+            {"bytes", total.bytes},
+            {"messages_per_s", messagesPerSecond},
+            {"bytes_per_s", bytesPerSecond},
+            {"events", total.latenciesNs.size()},
+            {"latency_us", {{"p50", p50}, {"p99", p99}, {"p99.9", p999}, {"max", maxUs}}}
+        };
+        std::printf("%-10s %12.1f %14.1f %10zu %10.1f %10.1f %10.1f\n",
+                    name.c_str(), messagesPerSecond, bytesPerSecond, total.latenciesNs.size(), p50, p99, p999);
+    }
+
+    std::ofstream(options.output) << report.dump(2) << "\n";
+    std::printf("Report written to %s\n", options.output.c_str());
+    return 0;
+}
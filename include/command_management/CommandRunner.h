@@ -2,6 +2,7 @@
 #ifndef COMMANDRUNNER_H
 #define COMMANDRUNNER_H
 
+#include <cstddef>
 #include <string>
 #include <vector>
 #include <chrono>
@@ -11,18 +12,24 @@
  *
  * The `CommandRunner` class provides functionality to execute commands with
  * optional arguments and manage execution parameters such as wait time.
+ *
+ * Commands are spawned directly, without a shell. A command given as a single string
+ * is split on whitespace, unless it uses shell syntax such as pipes, redirection,
+ * quotes or variables, in which case it is run with /bin/sh -c as before. stdout is
+ * read in large chunks into a buffer kept between runs and is cut off at the output
+ * limit; stderr and the exit status are kept separately.
  */
 class CommandRunner {
 public:
     /**
      * @brief Constructor for CommandRunner with a single command.
-     * @param command The command to execute.
+     * @param command The command to execute. Run through the shell only if it uses shell syntax.
      */
     CommandRunner(const std::string& command);
 
     /**
      * @brief Constructor for CommandRunner with a command and arguments.
-     * @param commandWithArgs The command and its arguments as a vector of strings.
+     * @param commandWithArgs The program and its arguments, passed on as they are.
      */
     CommandRunner(const std::vector<std::string>& commandWithArgs);
 
@@ -38,11 +45,19 @@ public:
      */
     void setWaitTime(int milliseconds);
 
+    /**
+     * @brief Sets the most stdout kept per execution. The command is killed once it writes more.
+     * @param bytes The limit in bytes, 0 for no limit.
+     */
+    void setOutputLimit(size_t bytes);
+
     /**
      * @brief Executes the command and returns the output.
-     * @return The output of the executed command.
+     * @details A command that cannot be started, e.g. because the program does not exist,
+     * fails with exit status 127 and no output, as it would in the shell.
+     * @return The output of the executed command, valid until the next execution.
      */
-    std::string execute();
+    const std::string& execute();
 
     /**
      * @brief Checks if the CommandRunner is ready for execution based on the wait time.
@@ -62,10 +77,47 @@ public:
      */
     int getWaitTime() const;
 
+    /**
+     * @brief Gets the output limit.
+     * @return The limit in bytes, 0 for no limit.
+     */
+    size_t getOutputLimit() const;
+
+    /**
+     * @brief Gets what the last execution wrote to stderr.
+     * @return The start of stderr, up to a fixed limit.
+     */
+    const std::string& getLastStderr() const;
+
+    /**
+     * @brief Gets the exit status of the last execution.
+     * @return The exit code, 128 plus the signal number if it was killed, or -1 if it never ran.
+     */
+    int getLastExitStatus() const;
+
+    /**
+     * @brief Checks if the last execution was cut off at the output limit.
+     * @return True if the output was truncated, false otherwise.
+     */
+    bool wasOutputTruncated() const;
+
 protected:
     std::vector<std::string> commandWithArgs_; ///< The command and its arguments.
+    bool useShell_; ///< Whether the command needs /bin/sh -c.
     int waitTime_; ///< The wait time between command executions.
+    size_t outputLimit_; ///< Most stdout bytes kept per execution, 0 for no limit.
+    std::string output_; ///< stdout of the last execution. Keeps its capacity between runs.
+    std::string stderr_; ///< Start of stderr of the last execution.
+    int lastExitStatus_; ///< Exit status of the last execution.
+    bool outputTruncated_; ///< Whether the last execution hit the output limit.
     std::chrono::time_point<std::chrono::high_resolution_clock> lastExecutionTime; ///< Timestamp of the last execution.
+
+    /**
+     * @brief Checks if a command uses shell syntax.
+     * @param command The command.
+     * @return True if it must be run by a shell, false if splitting on whitespace is enough.
+     */
+    static bool needsShell(const std::string& command);
 };
 
 #endif // COMMANDRUNNER_H
@@ -0,0 +1,141 @@
+// Subprocess.h
+#ifndef SUBPROCESS_H
+#define SUBPROCESS_H
+
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+/**
+ * @brief A child process whose output is read through non-blocking pipes.
+ *
+ * The `Subprocess` class runs a program in its own process group, so stopping it
+ * also stops any pipeline it started. It is spawned with posix_spawn, either from an
+ * argument vector, without a shell, or from a shell command. Output is read with
+ * readAvailable(), which never waits, so a long-running producer can be polled from
+ * the publish loop; waitForOutput() blocks for callers that want to run a command to
+ * completion. stderr is optionally captured through a pipe of its own.
+ */
+class Subprocess {
+public:
+    /**
+     * @brief Constructor for a shell command. Does not start the process.
+     * @param command The command, run with /bin/sh -c.
+     */
+    explicit Subprocess(const std::string& command);
+
+    /**
+     * @brief Constructor for a program run without a shell. Does not start the process.
+     * @param argv The program, looked up in PATH, and its arguments.
+     * @param captureStderr Whether stderr is captured instead of inherited.
+     */
+    explicit Subprocess(const std::vector<std::string>& argv, bool captureStderr = false);
+
+    /**
+     * @brief Destructor for Subprocess. Stops the process if it is still running.
+     */
+    ~Subprocess();
+
+    Subprocess(const Subprocess&) = delete;
+    Subprocess& operator=(const Subprocess&) = delete;
+
+    /**
+     * @brief Starts the process, stopping a previous one first.
+     * @return True if the process was started, false otherwise.
+     */
+    bool start();
+
+    /**
+     * @brief Appends whatever the process has written to stdout, without waiting.
+     * @param output The string to append to. Data is read straight into it.
+     * @param maxBytes Most bytes to append.
+     * @return The number of bytes appended.
+     */
+    size_t readAvailable(std::string& output, size_t maxBytes = std::numeric_limits<size_t>::max());
+
+    /**
+     * @brief Appends whatever the process has written to stderr, without waiting.
+     * @param output The string to append to.
+     * @param maxBytes Most bytes to append; anything beyond is read and discarded.
+     * @return The number of bytes appended.
+     */
+    size_t readAvailableStderr(std::string& output, size_t maxBytes = std::numeric_limits<size_t>::max());
+
+    /**
+     * @brief Waits until there is output to read or an output pipe has closed.
+     * @param timeoutMs Longest wait in milliseconds, -1 to wait indefinitely.
+     * @return True if there is something to read, false on timeout or when nothing is open.
+     */
+    bool waitForOutput(int timeoutMs);
+
+    /**
+     * @brief Checks if the process is still running, reaping it if it has exited.
+     * @return True if running, false otherwise.
+     */
+    bool isRunning();
+
+    /**
+     * @brief Checks if the process has closed its output.
+     * @return True once stdout, and stderr if captured, have been read to the end.
+     */
+    bool isAtEnd() const;
+
+    /**
+     * @brief Waits for the process to exit.
+     * @return The status as returned by waitpid, or -1 if there was no process.
+     */
+    int wait();
+
+    /**
+     * @brief Stops the process group with SIGTERM, then SIGKILL if it does not exit.
+     */
+    void stop();
+
+    /**
+     * @brief Gets the exit status of the last process.
+     * @return The status as returned by waitpid, or -1 if it has not exited.
+     */
+    int getExitStatus() const;
+
+    /**
+     * @brief Gets why the last start() failed to spawn the process.
+     * @return The errno value, e.g. ENOENT for a missing program, or 0 if it was spawned.
+     */
+    int getStartError() const;
+
+    /**
+     * @brief Gets the command.
+     * @return The shell command, or the arguments joined by spaces.
+     */
+    const std::string& getCommand() const;
+
+private:
+    std::vector<std::string> argv_; ///< Program and arguments, empty for a shell command.
+    std::string command_; ///< The shell command, or argv_ joined for logging.
+    bool captureStderr_; ///< Whether stderr is captured.
+    pid_t pid_; ///< Process ID, or -1 when not running.
+    int stdoutFd_; ///< Read end of the stdout pipe, or -1.
+    int stderrFd_; ///< Read end of the stderr pipe, or -1.
+    bool atEnd_; ///< Whether stdout has been closed.
+    int exitStatus_; ///< Status from waitpid, or -1.
+    int startError_; ///< errno of the last failed spawn, or 0.
+
+    /**
+     * @brief Reads what is available from a pipe, closing it at its end.
+     * @param fd The pipe; set to -1 once closed.
+     * @param output The string to append to.
+     * @param maxBytes Most bytes to append.
+     * @param discardExcess Whether to keep reading and drop data beyond maxBytes.
+     * @return The number of bytes appended.
+     */
+    size_t readPipe(int& fd, std::string& output, size_t maxBytes, bool discardExcess);
+
+    /**
+     * @brief Closes the read ends of the pipes.
+     */
+    void closePipes();
+};
+
+#endif // SUBPROCESS_H
@@ -5,7 +5,13 @@
 #include <vector>
 #include <string>
 #include <nlohmann/json.hpp>
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "utilities/JsonWriter.h"
 
 /**
  * @brief A circular buffer for storing data of a specified type.
@@ -13,6 +19,11 @@
  * The `DataBuffer` class implements a circular buffer to store data of a specified type.
  * It allows pushing new data into the buffer and provides methods to retrieve and serialize
  * the buffered data.
+ *
+ * Besides the entry count, the buffer can be bounded by a byte budget. Entries are
+ * counted by their payload size (the length of string entries, sizeof(T) otherwise),
+ * and the oldest are evicted once the budget is exceeded. The newest entry is always
+ * kept, so a single entry larger than the budget is still published.
  * 
  * @tparam T The type of data to be stored in the buffer.
  */
@@ -30,14 +41,91 @@ public:
      * @param data The data to be pushed into the buffer.
      */
     void Push(const T& data) {
+        residentBytes += EntryBytes(data);
         circularBuffer[head] = data;
-        head = (head + 1) % bufferSize;
+        advanceHead();
+    }
 
-        if (head == tail) {
-            tail = (tail + 1) % bufferSize; // Remove the oldest event if the buffer is full
+    /**
+     * @brief Pushes new data into the circular buffer, taking ownership of it.
+     * @param data The data to be moved into the buffer.
+     */
+    void Push(T&& data) {
+        residentBytes += EntryBytes(data);
+        circularBuffer[head] = std::move(data);
+        advanceHead();
+    }
+
+    /**
+     * @brief Sets the byte budget, evicting the oldest entries if it is already exceeded.
+     * @param bytes The most payload bytes to keep, or 0 for no limit.
+     */
+    void SetByteBudget(size_t bytes) {
+        byteBudget = bytes;
+        evictToBudget();
+    }
+
+    /**
+     * @brief Gets the byte budget.
+     * @return The most payload bytes kept, or 0 for no limit.
+     */
+    size_t ByteBudget() const {
+        return byteBudget;
+    }
+
+    /**
+     * @brief Gets the payload bytes of the buffered entries.
+     * @return The number of bytes.
+     */
+    size_t ResidentBytes() const {
+        return residentBytes;
+    }
+
+    /**
+     * @brief Gets the most payload bytes ever buffered at once.
+     * @return The number of bytes.
+     */
+    size_t PeakResidentBytes() const {
+        return peakResidentBytes;
+    }
+
+    /**
+     * @brief Gets the number of entries evicted to stay within the byte budget.
+     * @return The number of entries since construction.
+     */
+    uint64_t EvictedForBudget() const {
+        return evictedForBudget;
+    }
+
+    /**
+     * @brief Gets the payload size an entry counts against the byte budget.
+     * @param data The entry.
+     * @return The number of bytes.
+     */
+    static size_t EntryBytes(const T& data) {
+        if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            return std::string_view(data).size();
+        } else {
+            return sizeof(T);
         }
     }
 
+    /**
+     * @brief Gets the number of buffered entries.
+     * @return The number of entries.
+     */
+    size_t Size() const {
+        return (head + bufferSize - tail) % bufferSize;
+    }
+
+    /**
+     * @brief Gets the maximum number of buffered entries.
+     * @return One less than the buffer size; one slot separates head from tail.
+     */
+    size_t Capacity() const {
+        return bufferSize - 1;
+    }
+
     /**
      * @brief Gets the buffer content as a vector.
      * @return A vector containing the buffered data.
@@ -60,9 +148,27 @@ public:
      * @return A JSON string representing the buffered data.
      */
     std::string SerializeBuffer() const {
-        std::vector<T> buffer = GetBuffer();
-        nlohmann::json jsonBuffer(buffer);
-        return jsonBuffer.dump();
+        JsonWriter writer;
+        SerializeBuffer(writer);
+        return writer.release();
+    }
+
+    /**
+     * @brief Serializes the buffer content as a JSON array straight into a writer.
+     * @param writer The writer to append the array to.
+     * @details Entries are read in place, oldest first, without copying the buffer.
+     * String entries are written as escaped JSON strings, matching SerializeBuffer().
+     */
+    void SerializeBuffer(JsonWriter& writer) const {
+        writer.beginArray();
+        for (size_t i = tail; i != head; i = (i + 1) % bufferSize) {
+            if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+                writer.value(std::string_view(circularBuffer[i]));
+            } else {
+                writer.jsonValue(nlohmann::json(circularBuffer[i]));
+            }
+        }
+        writer.endArray();
     }
 
 private:
@@ -70,6 +176,42 @@ private:
     size_t head; ///< The index of the head in the circular buffer.
     size_t tail; ///< The index of the tail in the circular buffer.
     size_t bufferSize; ///< The size of the circular buffer.
+    size_t byteBudget = 0; ///< Most payload bytes to keep, 0 for no limit.
+    size_t residentBytes = 0; ///< Payload bytes of the buffered entries.
+    size_t peakResidentBytes = 0; ///< Most payload bytes ever buffered at once.
+    uint64_t evictedForBudget = 0; ///< Entries evicted to stay within the byte budget.
+
+    /**
+     * @brief Advances the head after a push, dropping the oldest entries when full or over budget.
+     */
+    void advanceHead() {
+        head = (head + 1) % bufferSize;
+
+        if (head == tail) {
+            dropTail(); // Remove the oldest event if the buffer is full
+        }
+        evictToBudget();
+        peakResidentBytes = std::max(peakResidentBytes, residentBytes);
+    }
+
+    /**
+     * @brief Evicts the oldest entries until the byte budget is met, keeping at least the newest.
+     */
+    void evictToBudget() {
+        while (byteBudget > 0 && residentBytes > byteBudget && Size() > 1) {
+            dropTail();
+            ++evictedForBudget;
+        }
+    }
+
+    /**
+     * @brief Drops the oldest entry and releases its memory.
+     */
+    void dropTail() {
+        residentBytes -= EntryBytes(circularBuffer[tail]);
+        circularBuffer[tail] = T();
+        tail = (tail + 1) % bufferSize;
+    }
     
     /**
      * @brief Optional method for cleanup logic.
@@ -5,6 +5,9 @@
 #include <string>
 #include <memory>
 #include "data_transmitter/DataChannelProcessesManager.h"
+#include "data_transmitter/TokenBucket.h"
+#include "utilities/JsonWriter.h"
+#include "metrics/MetricsRegistry.h"
 
 // Forward declarations to avoid circular imports
 class DataTransmitter;
@@ -16,6 +19,14 @@ class DataTransmitterManager;
  * The `DataChannel` class manages the publication of events for a specific channel.
  * It tracks the number of events published, events seen, and provides functionality
  * for handling breaks in event publication.
+ *
+ * Instead of breaks, a channel can be rate controlled: token buckets in messages
+ * and bytes per second are checked before the processors run, so a publish that
+ * is skipped costs nothing, and the actual size is debited once it is known.
+ *
+ * The channel's buffer can be bounded in bytes as well as in entries. The tighter of
+ * the channel's own byte budget and the share of the global budget the
+ * DataChannelManager allows it applies.
  */
 class DataChannel {
 public:
@@ -71,6 +82,28 @@ public:
      */
     void setAddress(const std::string& address);
 
+    /**
+     * @brief Switches the channel to rate control.
+     * @param messagesPerSecond Long-run message rate, 0 for unlimited.
+     * @param messageBurst Messages that may be published back to back.
+     * @param bytesPerSecond Long-run payload rate in bytes, 0 for unlimited.
+     * @param byteBurst Bytes that may be published back to back.
+     */
+    void setRateLimit(double messagesPerSecond, double messageBurst, double bytesPerSecond, double byteBurst);
+
+    /**
+     * @brief Checks if the channel is rate controlled.
+     * @return True if either the message or the byte rate is limited.
+     */
+    bool isRateControlled() const;
+
+    /**
+     * @brief Enables replay of the latest message to subscribers that join late.
+     * @return True if enabled, false otherwise.
+     * @see DataTransmitter::enableLastValueCache
+     */
+    bool enableSnapshotOnConnect();
+
     /**
      * @brief Gets the name of the data channel.
      * @return The name of the data channel.
@@ -154,8 +187,89 @@ public:
     /**
      * @brief Adds a GeneralProcessor to the DataChannelProcessesManager.
      * @param processor Pointer to the GeneralProcessor to add.
+     * @param processorType The processor type, used to label its metrics.
+     * @param priority The processor's priority when shedding load (default is 0).
+     * @param latencyBudgetMs Longest acceptable run in milliseconds, or 0 for the processor's period.
+     * @param maxSilenceMs Publish-on-change heartbeat in milliseconds, 0 for none, or -1 to publish every output.
+     * @see DataChannelProcessesManager::addProcessor
+     */
+    void addProcessToManager(GeneralProcessor* processor, const std::string& processorType = "GeneralProcessor",
+                             int priority = 0, int latencyBudgetMs = 0, int maxSilenceMs = -1);
+
+    /**
+     * @brief Sets the channel's priority when shedding load.
+     * @param priority The priority; higher values are shed last.
      */
-    void addProcessToManager(GeneralProcessor* processor);
+    void setPriority(int priority);
+
+    /**
+     * @brief Gets the channel's priority when shedding load.
+     * @return The priority.
+     */
+    int getPriority() const;
+
+    /**
+     * @brief Sets the longest acceptable publish.
+     * @param latencyBudgetMs The budget in milliseconds, or 0 for none.
+     */
+    void setLatencyBudget(int latencyBudgetMs);
+
+    /**
+     * @brief Gets the longest acceptable publish.
+     * @return The budget in milliseconds, or 0 for none.
+     */
+    int getLatencyBudget() const;
+
+    /**
+     * @brief Sets the priority below which due processors are skipped.
+     * @param threshold The priority threshold, INT_MIN to run everything.
+     * @details Processors at or above the channel's own priority are never skipped; they
+     * are shed with the channel instead.
+     * @see LoadShedder
+     */
+    void setSheddingThreshold(int threshold);
+
+    /**
+     * @brief Gets the priorities of the channel's processors.
+     * @return The priorities.
+     */
+    const std::vector<int>& getProcessorPriorities() const;
+
+    /**
+     * @brief Gets the number of processors the last publish() ran over their latency budget.
+     * @return The number of processors.
+     */
+    size_t getProcessorBudgetMisses() const;
+
+    /**
+     * @brief Sets the channel's own byte budget for its buffer.
+     * @param bytes The most payload bytes to keep, or 0 for no limit.
+     */
+    void setBufferByteBudget(size_t bytes);
+
+    /**
+     * @brief Gets the channel's own byte budget for its buffer.
+     * @return The most payload bytes kept, or 0 for no limit.
+     */
+    size_t getBufferByteBudget() const;
+
+    /**
+     * @brief Limits the buffer to a share of the global byte budget, on top of its own budget.
+     * @param allowance The most payload bytes the channel may keep, or 0 for no global limit.
+     */
+    void limitBufferBytes(size_t allowance);
+
+    /**
+     * @brief Gets the payload bytes held in the channel's buffer.
+     * @return The number of bytes.
+     */
+    size_t getBufferResidentBytes() const;
+
+    /**
+     * @brief Gets the metrics of the data channel.
+     * @return The channel's metrics, shared by every channel with the same name.
+     */
+    ChannelMetrics& getMetrics() const;
 
     /**
      * @brief Updates the tick time for the data channel.
@@ -174,6 +288,25 @@ private:
     std::shared_ptr<DataTransmitter> transmitter; ///< DataTransmitter for publishing events.
     DataChannelProcessesManager processesManager; ///< Manager for data channel processes.
     int tickTime; ///< Tick time for the data channel.
+    JsonWriter serializationWriter; ///< Writer the data buffer is serialized into before publishing.
+    ChannelMetrics* metrics; ///< Metrics of this channel, owned by the MetricsRegistry.
+    int priority; ///< Priority when shedding load; higher values are shed last.
+    int latencyBudgetMs; ///< Longest acceptable publish in milliseconds, 0 for none.
+    TokenBucket messageBucket; ///< Limits messages per second in rate-control mode.
+    TokenBucket byteBucket; ///< Limits payload bytes per second in rate-control mode.
+    size_t bufferByteBudget; ///< The channel's own byte budget for its buffer, 0 for none.
+    uint64_t bufferEvictionsReported; ///< Buffer evictions already added to the metrics.
+
+    /**
+     * @brief Checks the token buckets before a publish.
+     * @return True if the publish may go ahead, false if it is skipped.
+     */
+    bool admitRate();
+
+    /**
+     * @brief Updates the buffer size and eviction metrics.
+     */
+    void updateBufferMetrics();
 
     /**
      * @brief Checks if a break should be taken based on the configured criteria in \ref config.json.
@@ -8,12 +8,17 @@
 #include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
 #include "data_transmitter/DataChannel.h"
+#include "data_transmitter/LoadShedder.h"
 
 /**
  * @brief Manages data channels and their configuration.
  *
  * The `DataChannelManager` class is responsible for managing data channels,
  * providing access to individual channels, and coordinating their publication.
+ *
+ * When load shedding is enabled, channels whose priority is shed publish only every
+ * few loops and processors whose priority is shed are skipped, lowest priority first.
+ * @see LoadShedder
  */
 class DataChannelManager {
 public:
@@ -32,6 +37,20 @@ public:
      */
     bool publish();
 
+    /**
+     * @brief Configures load shedding across all channels added so far.
+     * @param config The general-settings.load-shedding object.
+     */
+    void configureLoadShedding(const nlohmann::json& config);
+
+    /**
+     * @brief Sets the byte budget shared by the buffers of all channels.
+     * @param bytes The most payload bytes to keep across all buffers, or 0 for no limit.
+     * @details Each channel may keep at least an equal share, and more while the others
+     * leave room. A channel's own budget still applies on top.
+     */
+    void setBufferByteBudget(size_t bytes);
+
     /**
      * @brief Gets a pointer to a specific data channel by ID.
      * @param channelId The ID of the data channel to retrieve.
@@ -93,6 +112,24 @@ private:
     std::map<std::string, DataChannel> channels; ///< Map of data channels.
     int globalTickTime; ///< Global tick time for data channel publication.
     int verbose; ///< Verbosity level for logging.
+    LoadShedder loadShedder; ///< Decides which priorities to shed when falling behind.
+    size_t loopCount; ///< Number of publish() calls so far.
+    size_t bufferByteBudget; ///< Byte budget shared by all channel buffers, 0 for none.
+    size_t peakBufferBytes; ///< Most payload bytes ever held across all channel buffers.
+    Gauge* bufferBytesGauge; ///< Exposes the payload bytes held across all channel buffers.
+    Gauge* peakBufferBytesGauge; ///< Exposes peakBufferBytes.
+
+    /**
+     * @brief Gets how far the live MIDAS event consumers have fallen behind.
+     * @return The fullest consumer queue's fill, or 0 if nothing reads live events.
+     */
+    double getReceiverFill() const;
+
+    /**
+     * @brief Gets the payload bytes held across all channel buffers.
+     * @return The number of bytes.
+     */
+    size_t getBufferResidentBytes() const;
 
     // Private method for getting a value from JSON with default and warning
     template<typename T>
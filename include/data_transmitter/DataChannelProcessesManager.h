@@ -4,8 +4,11 @@
 
 #include <vector>
 #include <memory>
+#include <chrono>
+#include <cstdint>
 #include "processors/GeneralProcessor.h"
 #include "data_transmitter/DataBuffer.h"
+#include "metrics/MetricsRegistry.h"
 
 /**
  * @brief Manages data channel processors and their execution.
@@ -13,6 +16,10 @@
  * The `DataChannelProcessesManager` class is responsible for managing a collection of
  * data channel processors and coordinating their execution. It also maintains a data buffer
  * to store the output generated by the processors.
+ *
+ * Processors added with publish-on-change only push output that differs from what they
+ * pushed last, compared by a 64-bit xxHash of the output. Unchanged output is still
+ * pushed once the processor has been silent for its maximum silence, as a heartbeat.
  */
 class DataChannelProcessesManager {
 public:
@@ -26,10 +33,53 @@ public:
     /**
      * @brief Adds a data channel processor to the manager.
      * @param processor Pointer to the GeneralProcessor to add.
+     * @param metrics Metrics to record the processor's runs in, or nullptr.
+     * @param priority The processor's priority when shedding load (default is 0).
+     * @param latencyBudgetMs Longest acceptable run in milliseconds, or 0 for the processor's period.
+     * @param maxSilenceMs Publish only changed output, resending unchanged output after this many
+     *                     milliseconds (0 for never); -1 to publish every output.
      * @details This is automatically done based on the config.
      * @see DataChannelManager::addChannel
      */
-    void addProcessor(GeneralProcessor* processor);
+    void addProcessor(GeneralProcessor* processor, ProcessorMetrics* metrics = nullptr, int priority = 0,
+                      int latencyBudgetMs = 0, int maxSilenceMs = -1);
+
+    /**
+     * @brief Gets the number of processors.
+     * @return The number of processors.
+     */
+    size_t getProcessorCount() const;
+
+    /**
+     * @brief Gets the number of entries the last runProcesses() pushed into the data buffer.
+     * @return The number of entries.
+     */
+    size_t getEntriesAddedLastRun() const;
+
+    /**
+     * @brief Gets the number of entries the last runProcesses() left out for being unchanged.
+     * @return The number of entries.
+     */
+    size_t getEntriesSuppressedLastRun() const;
+
+    /**
+     * @brief Gets the number of processors the last runProcesses() ran over their latency budget.
+     * @return The number of processors.
+     */
+    size_t getBudgetMissesLastRun() const;
+
+    /**
+     * @brief Sets the priority below which due processors are skipped instead of run.
+     * @param threshold The priority threshold, INT_MIN to run everything.
+     * @see LoadShedder
+     */
+    void setSheddingThreshold(int threshold);
+
+    /**
+     * @brief Gets the priorities of all processors.
+     * @return The priorities, in the order the processors were added.
+     */
+    const std::vector<int>& getProcessorPriorities() const;
 
     /**
      * @brief Runs all registered processors and adds their output to the data buffer.
@@ -37,12 +87,24 @@ public:
      */
     bool runProcesses();
 
+    /**
+     * @brief Checks whether any processor is due to run.
+     * @return True if runProcesses() would run at least one processor.
+     */
+    bool hasReadyProcessor() const;
+
     /**
      * @brief Gets the data buffer.
      * @return Reference to the data buffer.
      */
     const DataBuffer<std::string>& getDataBuffer() const;
 
+    /**
+     * @brief Sets the data buffer's byte budget, evicting the oldest entries if it is exceeded.
+     * @param bytes The most payload bytes to keep, or 0 for no limit.
+     */
+    void setBufferByteBudget(size_t bytes);
+
     /**
      * @brief Updates the greatest common divisor (GCD) of processor periods.
      * @details Used to find the a psuedo-optimal sleep time between publishes.
@@ -57,6 +119,16 @@ public:
 
 private:
     std::vector<GeneralProcessor*> processors; ///< Collection of data channel processors.
+    std::vector<ProcessorMetrics*> processorMetrics; ///< Metrics per processor (may be nullptr).
+    std::vector<int> processorPriorities; ///< Load-shedding priority per processor.
+    std::vector<int> processorLatencyBudgets; ///< Latency budget per processor in ms, 0 for its period.
+    std::vector<int> processorMaxSilences; ///< Publish-on-change heartbeat per processor in ms, -1 if off.
+    std::vector<uint64_t> lastOutputHashes; ///< Hash of the output each processor last pushed.
+    std::vector<std::chrono::steady_clock::time_point> lastOutputTimes; ///< When each processor last pushed output.
+    size_t entriesAddedLastRun; ///< Entries pushed by the last runProcesses().
+    size_t entriesSuppressedLastRun; ///< Unchanged entries left out by the last runProcesses().
+    size_t budgetMissesLastRun; ///< Processors over their latency budget in the last runProcesses().
+    int sheddingThreshold; ///< Processors with a lower priority are skipped.
     DataBuffer<std::string> dataBuffer; ///< Data buffer to store processor output.
     int verbose; ///< Verbosity level for printout and logging.
     int processorPeriodsGcd; ///< Greatest common divisor (GCD) of processor periods.
@@ -66,6 +138,14 @@ private:
      * @return The GCD of processor periods.
      */
     int findGCDOfProcessorPeriods();
+
+    /**
+     * @brief Checks if a publish-on-change processor's output must be pushed, and records it if so.
+     * @param index The processor's position.
+     * @param output The processor's output.
+     * @return True if the output changed or the processor has been silent too long, false otherwise.
+     */
+    bool isOutputDue(size_t index, const std::vector<std::string>& output);
 };
 
 #endif // DATACHANNELPROCESSESMANAGER_H
@@ -3,15 +3,24 @@
 #define DATATRANSMITTER_H
 
 #include <string>
+#include <map>
+#include <memory>
 #include <zmq.hpp>
 #include <iostream>
 #include "data_transmitter/DataChannel.h"
+#include "data_transmitter/StreamRecorder.h"
+#include "data_transmitter/PayloadInspector.h"
 
 /**
  * @brief Transmits data over a ZeroMQ (zmq) publisher socket.
  *
  * The `DataTransmitter` class provides functionality for binding to a zmq publisher socket
  * and publishing data to a specific zmq-address.
+ *
+ * When the last-value cache is enabled, the socket is an XPUB socket instead and the
+ * latest payload of every topic is kept. Each new subscription is answered by
+ * replaying the cached payloads matching its prefix, so late joiners do not have to
+ * wait a full period for data.
  */
 class DataTransmitter {
 public:
@@ -48,18 +57,120 @@ public:
      */
     bool publish(DataChannel& dataChannel, const std::string& data);
 
+    /**
+     * @brief Publishes data to the specified data channel, taking ownership of the buffer.
+     * @param dataChannel The data channel to publish to.
+     * @param data The data to publish. It is handed to zmq without copying.
+     * @return True if successful (this does not necessarily mean data is published),
+     * false otherwise.
+     */
+    bool publish(DataChannel& dataChannel, std::string&& data);
+
+    /**
+     * @brief Publishes a payload on a topic directly, binding first if needed.
+     * @param topic The topic frame (empty to send the payload alone).
+     * @param payload The payload. It is handed to zmq without copying.
+     * @return True if successful, false otherwise.
+     * @details Bypasses channel bookkeeping; used to replay recordings.
+     */
+    bool publish(const std::string& topic, std::shared_ptr<const std::string> payload);
+
+    /**
+     * @brief Sets a recorder that receives a copy of every published message.
+     * @param recorder The recorder to use, or nullptr to stop recording.
+     */
+    void setRecorder(std::shared_ptr<StreamRecorder> recorder);
+
+    /**
+     * @brief Sets an inspector that logs a sample of the published messages.
+     * @param inspector The inspector to use, or nullptr to stop inspecting.
+     */
+    void setPayloadInspector(std::shared_ptr<PayloadInspector> inspector);
+
     /**
      * @brief Sets the verbosity level for logging.
      * @param enableVerbose Verbosity level to set.
      */
     void setVerbose(int enableVerbose);
 
+    /**
+     * @brief Switches the transmitter to an XPUB socket with a last-value cache.
+     * @return True if enabled, false if the socket is already bound.
+     * @details Must be called before the first bind. The cache applies to every
+     * channel sharing this zmq-address.
+     */
+    bool enableLastValueCache();
+
+    /**
+     * @brief Checks if the last-value cache is enabled.
+     * @return True if enabled, false otherwise.
+     */
+    bool hasLastValueCache() const;
+
+    /**
+     * @brief Reads pending subscription messages and replays cached payloads to them.
+     * @return The number of cached payloads replayed.
+     */
+    size_t serviceSubscriptions();
+
+    /**
+     * @brief Gets the underlying socket handle, for polling.
+     * @return The raw zmq socket handle.
+     */
+    void* getSocketHandle();
+
+    /**
+     * @brief Gets the zmq context owning the socket.
+     * @return The zmq context, needed to connect to inproc:// addresses.
+     */
+    zmq::context_t& getContext();
+
 private:
     zmq::context_t context; ///< ZeroMQ context.
     zmq::socket_t publisher; ///< ZeroMQ publisher socket.
     std::string zmqAddress; ///< The zmq-address to which the transmitter is bound.
     int verbose; ///< Verbosity level for logging.
     bool isBoundToSocket; ///< Flag indicating if the transmitter is bound to the zmq publisher socket.
+    bool lastValueCacheEnabled; ///< Flag indicating if the socket is XPUB with a last-value cache.
+    std::map<std::string, std::shared_ptr<const std::string>> lastValues; ///< Latest payload per topic.
+    std::shared_ptr<StreamRecorder> recorder; ///< Optional sink recording every published message.
+    std::shared_ptr<PayloadInspector> payloadInspector; ///< Optional inspector logging sampled messages.
+
+    /**
+     * @brief Counts the publish attempt and checks whether the channel is on a break.
+     * @param dataChannel The data channel being published to.
+     * @return True if the data should be sent, false if the channel is on a break.
+     */
+    bool admit(DataChannel& dataChannel);
+
+    /**
+     * @brief Sends an admitted payload to a channel and records it in the channel's metrics.
+     * @param dataChannel The data channel being published to.
+     * @param payload The payload. It is handed to zmq without copying.
+     * @return True if successful, false otherwise.
+     */
+    bool sendToChannel(DataChannel& dataChannel, std::shared_ptr<const std::string> payload);
+
+    /**
+     * @brief Sends a payload on a topic, caching it if the last-value cache is enabled.
+     * @param channel The channel name used as topic.
+     * @param payload The payload. It is handed to zmq without copying.
+     */
+    void sendPayload(const std::string& channel, std::shared_ptr<const std::string> payload);
+
+    /**
+     * @brief Sends the topic frame (if the channel is named) followed by the payload.
+     * @param channel The channel name used as topic.
+     * @param payload The payload. zmq keeps a reference until the message is sent.
+     */
+    void sendFrames(const std::string& channel, const std::shared_ptr<const std::string>& payload);
+
+    /**
+     * @brief Logs a publish and passes it to the payload inspector, if any.
+     * @param dataChannel The data channel published to.
+     * @param payload The published payload.
+     */
+    void logPublish(const DataChannel& dataChannel, const std::shared_ptr<const std::string>& payload) const;
 };
 
 #endif // DATATRANSMITTER_H
@@ -58,6 +58,28 @@ public:
      */
     void setVerbose(int enableVerbose);
 
+    /**
+     * @brief Waits for the given time while answering new subscriptions.
+     * @param milliseconds How long to wait.
+     * @details Transmitters with a last-value cache are polled so snapshots go out as
+     * soon as a subscriber joins. Without any, this is a plain sleep. A signal ends
+     * the wait early.
+     * @see DataTransmitter::serviceSubscriptions
+     */
+    void waitForSubscriptions(int milliseconds);
+
+    /**
+     * @brief Sets the recorder attached to every current and future transmitter.
+     * @param recorder The recorder to use, or nullptr to stop recording.
+     */
+    void setRecorder(std::shared_ptr<StreamRecorder> recorder);
+
+    /**
+     * @brief Sets the payload inspector attached to every current and future transmitter.
+     * @param inspector The inspector to use, or nullptr to stop inspecting.
+     */
+    void setPayloadInspector(std::shared_ptr<PayloadInspector> inspector);
+
     /**
      * @brief Static method to get the singleton instance of DataTransmitterManager.
      * @param verbose Verbosity level for logging (default is 0).
@@ -68,6 +90,8 @@ public:
 private:
     int verbose; ///< Verbosity level for logging.
     std::map<std::string, std::shared_ptr<DataTransmitter>> transmitterMap; ///< Map of zmq-addresses to DataTransmitters.
+    std::shared_ptr<StreamRecorder> recorder; ///< Recorder attached to every transmitter, if any.
+    std::shared_ptr<PayloadInspector> payloadInspector; ///< Inspector attached to every transmitter, if any.
 };
 
 #endif // DATATRANSMITTERMANAGER_H
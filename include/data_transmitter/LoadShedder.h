@@ -0,0 +1,121 @@
+// LoadShedder.h
+#ifndef LOAD_SHEDDER_H
+#define LOAD_SHEDDER_H
+
+#include <climits>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "metrics/Metrics.h"
+
+/**
+ * @brief One loop's worth of load signals.
+ */
+struct LoadSample {
+    double loopMs = 0; ///< Time taken to publish every channel once.
+    double tickMs = 0; ///< Time available per loop.
+    size_t budgetMisses = 0; ///< Channels and processors that exceeded their latency budget.
+    double receiverFill = 0; ///< Fill of the most backed-up live event consumer queue.
+};
+
+/**
+ * @brief Decides how much low-priority work to shed when the publisher falls behind.
+ *
+ * The `LoadShedder` class walks through the distinct channel and processor priorities,
+ * lowest first. After a number of consecutive lagging loops it raises its threshold to
+ * the next priority, so that everything below it is shed; after a longer run of loops
+ * with headroom it lowers the threshold again. The highest priority is never shed.
+ *
+ * A loop lags when it overruns the tick, when any channel or processor exceeds its
+ * latency budget, or when the receiver's buffer is filling up. What shedding means is
+ * up to the caller: DataChannelManager decimates channels and skips processors below
+ * the threshold.
+ *
+ * Configured from general-settings.load-shedding:
+ * @code
+ * "load-shedding": {
+ *   "enabled": false,
+ *   "overload-loops": 3,
+ *   "recovery-loops": 50,
+ *   "recovery-headroom": 0.5,
+ *   "receiver-fill-threshold": 0.8,
+ *   "channel-decimation": 10
+ * }
+ * @endcode
+ */
+class LoadShedder {
+public:
+    /**
+     * @brief Constructs a disabled load shedder.
+     */
+    LoadShedder();
+
+    /**
+     * @brief Applies the load-shedding settings.
+     * @param config The general-settings.load-shedding object.
+     */
+    void configure(const nlohmann::json& config);
+
+    /**
+     * @brief Sets the priorities that can be shed, one entry per channel or processor.
+     * @param priorities The priorities, in any order and with duplicates.
+     */
+    void setPriorities(const std::vector<int>& priorities);
+
+    /**
+     * @brief Checks if load shedding is enabled.
+     * @return True if enabled, false otherwise.
+     */
+    bool isEnabled() const;
+
+    /**
+     * @brief Feeds one loop's load signals and moves the threshold if needed.
+     * @param sample The loop's load signals.
+     * @return True if the threshold changed, false otherwise.
+     */
+    bool update(const LoadSample& sample);
+
+    /**
+     * @brief Checks if work at a given priority is currently shed.
+     * @param priority The priority of the work.
+     * @return True if the priority is below the threshold, false otherwise.
+     */
+    bool isShed(int priority) const;
+
+    /**
+     * @brief Gets the priority below which work is shed.
+     * @return The threshold, or INT_MIN while nothing is shed.
+     */
+    int getThreshold() const;
+
+    /**
+     * @brief Gets how many loops a shed channel waits between publishes.
+     * @return The decimation factor.
+     */
+    int getChannelDecimation() const;
+
+private:
+    bool enabled; ///< Whether shedding is enabled.
+    int overloadLoops; ///< Consecutive lagging loops before shedding one more priority.
+    int recoveryLoops; ///< Consecutive healthy loops before restoring one priority.
+    double recoveryHeadroom; ///< Fraction of the tick a loop may use and still count as healthy.
+    double receiverFillThreshold; ///< Consumer queue fill counted as lagging.
+    int channelDecimation; ///< Loops between publishes of a shed channel.
+    std::vector<int> levels; ///< Distinct priorities, ascending.
+    size_t stage; ///< Number of priorities currently shed.
+    int laggingLoops; ///< Consecutive lagging loops seen.
+    int healthyLoops; ///< Consecutive healthy loops seen.
+    Gauge* stageGauge; ///< Exposes the number of priorities shed.
+    Counter* shedDecisions; ///< Times a priority was shed.
+    Counter* recoverDecisions; ///< Times a priority was restored.
+
+    /**
+     * @brief Describes why a loop counts as lagging, for the log.
+     * @param sample The loop's load signals.
+     * @return The reasons.
+     */
+    std::string describeLag(const LoadSample& sample) const;
+};
+
+#endif // LOAD_SHEDDER_H
@@ -0,0 +1,54 @@
+// PayloadInspector.h
+#ifndef PAYLOADINSPECTOR_H
+#define PAYLOADINSPECTOR_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include "data_transmitter/StreamRecorder.h"
+
+/**
+ * @brief Logs a sample of published payloads for debugging.
+ *
+ * The `PayloadInspector` class looks at the first and then every Nth message of each
+ * channel. For those it logs the size, an xxHash64 of the whole payload and the first
+ * bytes, read in place without copying. Optionally the sampled payloads are also
+ * handed to a StreamRecorder, which writes them from its own thread, so the full
+ * payloads can be examined or replayed later without slowing the publish loop.
+ */
+class PayloadInspector {
+public:
+    /**
+     * @brief Constructor for PayloadInspector.
+     * @param sampleEvery Inspect one message in this many per channel (0 is treated as 1).
+     * @param previewBytes Number of leading payload bytes to log.
+     * @param tee Recorder sampled payloads are also written to, or nullptr.
+     */
+    PayloadInspector(uint64_t sampleEvery, size_t previewBytes, std::shared_ptr<StreamRecorder> tee = nullptr);
+
+    /**
+     * @brief Counts a published message and inspects it if it is sampled.
+     * @param address The zmq-address the message is published on.
+     * @param channel The channel name.
+     * @param payload The payload. It is shared with the recorder, not copied.
+     * @return True if the message was sampled, false otherwise.
+     */
+    bool inspect(const std::string& address, const std::string& channel,
+                 const std::shared_ptr<const std::string>& payload);
+
+    /**
+     * @brief Gets the number of messages inspected so far.
+     * @return The number of messages.
+     */
+    uint64_t getInspectedCount() const;
+
+private:
+    uint64_t sampleEvery; ///< Inspect one message in this many per channel.
+    size_t previewBytes; ///< Number of leading payload bytes to log.
+    std::shared_ptr<StreamRecorder> tee; ///< Recorder sampled payloads are written to, if any.
+    std::unordered_map<std::string, uint64_t> messagesSeen; ///< Messages counted per channel.
+    uint64_t inspectedCount; ///< Messages inspected.
+};
+
+#endif // PAYLOADINSPECTOR_H
@@ -0,0 +1,125 @@
+// StreamRecorder.h
+#ifndef STREAMRECORDER_H
+#define STREAMRECORDER_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <cstdio>
+#include <cstdint>
+#include <chrono>
+
+/**
+ * @brief On-disk layout shared by StreamRecorder and StreamReplayer.
+ *
+ * A recording is a directory of segment files. Each segment starts with the 8-byte
+ * file magic and is followed by records, each a RecordHeader and then the zmq-address,
+ * topic and payload bytes. Integers are stored in host byte order.
+ */
+namespace stream_recording {
+
+constexpr char FILE_MAGIC[8] = {'P', 'U', 'B', 'R', 'E', 'C', '0', '1'};
+constexpr uint32_t RECORD_MAGIC = 0x31434552; ///< "REC1"
+constexpr const char* SEGMENT_EXTENSION = ".rec";
+
+struct RecordHeader {
+    uint32_t magic;        ///< Always RECORD_MAGIC, used to detect corruption.
+    uint32_t addressSize;  ///< Length of the zmq-address that follows.
+    uint32_t topicSize;    ///< Length of the topic that follows.
+    uint32_t reserved;     ///< Padding, always 0.
+    uint64_t timestampNs;  ///< Publish time in nanoseconds since the epoch.
+    uint64_t payloadSize;  ///< Length of the payload that follows.
+};
+
+} // namespace stream_recording
+
+/**
+ * @brief Records every published message to a segmented binary log.
+ *
+ * The `StreamRecorder` class queues messages from the publish path and writes them
+ * from a background thread using large buffered sequential writes. Payloads are
+ * shared with the transmitter, so queueing a message does not copy it. If the
+ * writer falls behind by more than the configured queue size, new messages are
+ * dropped and counted rather than stalling publication.
+ */
+class StreamRecorder {
+public:
+    /**
+     * @brief Constructor for StreamRecorder. Starts the writer thread.
+     * @param directory Directory the segment files are written to (created if missing).
+     * @param segmentSizeBytes Size after which a new segment file is started.
+     * @param maxQueuedBytes Payload bytes allowed to wait for the writer before dropping.
+     * @param verbose Verbosity level for logging (default is 0).
+     */
+    StreamRecorder(const std::string& directory, size_t segmentSizeBytes, size_t maxQueuedBytes, int verbose = 0);
+
+    /**
+     * @brief Destructor for StreamRecorder. Drains the queue and closes the segment.
+     */
+    ~StreamRecorder();
+
+    StreamRecorder(const StreamRecorder&) = delete;
+    StreamRecorder& operator=(const StreamRecorder&) = delete;
+
+    /**
+     * @brief Queues a message for recording.
+     * @param address The zmq-address the message was published on.
+     * @param topic The topic frame (empty for unnamed channels).
+     * @param payload The payload frame.
+     */
+    void record(const std::string& address, const std::string& topic, std::shared_ptr<const std::string> payload);
+
+    /**
+     * @brief Gets the number of messages written to disk.
+     * @return The number of recorded messages.
+     */
+    uint64_t getRecordedCount() const;
+
+    /**
+     * @brief Gets the number of messages dropped because the writer fell behind.
+     * @return The number of dropped messages.
+     */
+    uint64_t getDroppedCount() const;
+
+private:
+    struct Record {
+        uint64_t timestampNs;
+        std::string address;
+        std::string topic;
+        std::shared_ptr<const std::string> payload;
+    };
+
+    std::string directory_; ///< Output directory.
+    size_t segmentSizeBytes_; ///< Segment rollover size.
+    size_t maxQueuedBytes_; ///< Queue limit in payload bytes.
+    int verbose_; ///< Verbosity level for logging.
+
+    std::mutex mutex_; ///< Guards the queue.
+    std::condition_variable wakeup_; ///< Signals the writer.
+    std::vector<Record> queue_; ///< Messages waiting for the writer.
+    size_t queuedBytes_; ///< Payload bytes in the queue.
+    bool stopping_; ///< Set on destruction.
+
+    std::FILE* segment_; ///< Currently open segment, if any.
+    std::vector<char> segmentBuffer_; ///< stdio buffer for the open segment.
+    size_t segmentBytes_; ///< Bytes written to the open segment.
+    unsigned segmentIndex_; ///< Index of the open segment.
+    std::string sessionName_; ///< Timestamp-based prefix of this session's segment names.
+    std::chrono::steady_clock::time_point lastFlush_; ///< Last time the segment was flushed.
+
+    std::atomic<uint64_t> recordedCount_; ///< Messages written.
+    std::atomic<uint64_t> droppedCount_; ///< Messages dropped.
+
+    std::thread writer_; ///< Background writer thread.
+
+    void writerLoop();
+    bool writeRecord(const Record& record);
+    bool openSegment();
+    void closeSegment();
+};
+
+#endif // STREAMRECORDER_H
@@ -0,0 +1,62 @@
+// StreamReplayer.h
+#ifndef STREAMREPLAYER_H
+#define STREAMREPLAYER_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstdio>
+
+/**
+ * @brief Re-publishes a recording made by StreamRecorder.
+ *
+ * The `StreamReplayer` class reads the segment files of a recording in order and
+ * publishes every record on its original zmq-address and topic, through the same
+ * transmitters the live publisher uses.
+ */
+class StreamReplayer {
+public:
+    /**
+     * @brief Constructor for StreamReplayer.
+     * @param path A recording directory or a single segment file.
+     * @param speed Playback speed relative to the original timing; 0 replays as fast as possible.
+     * @param verbose Verbosity level for logging (default is 0).
+     */
+    StreamReplayer(const std::string& path, double speed, int verbose = 0);
+
+    /**
+     * @brief Replays the recording until it ends or a quit signal is received.
+     * @return True if every segment was read successfully, false otherwise.
+     */
+    bool run();
+
+    /**
+     * @brief Gets the number of messages published so far.
+     * @return The number of replayed messages.
+     */
+    uint64_t getReplayedCount() const;
+
+private:
+    std::string path_; ///< Recording directory or segment file.
+    double speed_; ///< Playback speed; 0 means maximum speed.
+    int verbose_; ///< Verbosity level for logging.
+    uint64_t replayedCount_; ///< Messages published.
+    uint64_t replayedBytes_; ///< Payload bytes published.
+
+    /**
+     * @brief Lists the segment files to replay, in recording order.
+     * @return Sorted segment paths.
+     */
+    std::vector<std::string> listSegments() const;
+
+    /**
+     * @brief Replays one segment file.
+     * @param segmentPath Path of the segment.
+     * @param firstTimestampNs Recording time of the first record, set on the first call.
+     * @param startTime Wall time the replay started, in steady-clock nanoseconds.
+     * @return True if the segment was read to its end, false on error or quit.
+     */
+    bool replaySegment(const std::string& segmentPath, uint64_t& firstTimestampNs, int64_t startTime);
+};
+
+#endif // STREAMREPLAYER_H
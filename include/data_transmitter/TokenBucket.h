@@ -0,0 +1,74 @@
+// TokenBucket.h
+#ifndef TOKEN_BUCKET_H
+#define TOKEN_BUCKET_H
+
+#include <chrono>
+
+/**
+ * @brief A token bucket limiting a long-run rate while allowing bursts.
+ *
+ * The `TokenBucket` class refills at a fixed rate up to its burst size. Callers check
+ * for tokens before doing expensive work and consume what the work actually cost
+ * afterwards, which may leave the bucket in debt; a bucket in debt has no tokens
+ * until the refill has paid the debt back. This keeps the average rate flat even when
+ * the cost of each item is only known after it has been produced.
+ *
+ * A bucket with a rate of zero is unlimited.
+ */
+class TokenBucket {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Constructs an unlimited bucket.
+     */
+    TokenBucket();
+
+    /**
+     * @brief Constructs a bucket, starting full.
+     * @param ratePerSecond Tokens added per second, 0 for unlimited.
+     * @param burst Maximum number of tokens held, at least 1 so a single item can always pass.
+     */
+    TokenBucket(double ratePerSecond, double burst);
+
+    /**
+     * @brief Checks if the bucket limits anything.
+     * @return True if the rate is positive, false if unlimited.
+     */
+    bool isLimited() const;
+
+    /**
+     * @brief Checks if at least some tokens are available.
+     * @param amount Tokens needed; 0 only requires the bucket not to be in debt.
+     * @param now The current time.
+     * @return True if the tokens are available, or if the bucket is unlimited.
+     */
+    bool hasTokens(double amount, Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Removes tokens, going into debt if there are not enough.
+     * @param amount Tokens to remove.
+     * @param now The current time.
+     */
+    void consume(double amount, Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Gets the tokens currently held.
+     * @return The tokens, negative while in debt.
+     */
+    double getTokens() const;
+
+private:
+    double ratePerSecond; ///< Tokens added per second.
+    double burst; ///< Maximum number of tokens held.
+    double tokens; ///< Tokens held, negative while in debt.
+    Clock::time_point lastRefill; ///< When tokens were last added.
+
+    /**
+     * @brief Adds the tokens accrued since the last refill.
+     * @param now The current time.
+     */
+    void refill(Clock::time_point now);
+};
+
+#endif // TOKEN_BUCKET_H
@@ -0,0 +1,51 @@
+// EventSampler.h
+#ifndef EVENT_SAMPLER_H
+#define EVENT_SAMPLER_H
+
+#include "event_sources/EventSource.h"
+#include <nlohmann/json.hpp>
+#include <memory>
+#include <string>
+
+/**
+ * @brief An abstract policy choosing which events MidasEventProcessor unpacks.
+ *
+ * The `EventSampler` class sits between the event source and the pipeline, so
+ * events it drops never pay the unpacking and serialization cost. Samplers keep
+ * state across calls; a sampler may hold events back and release them later.
+ */
+class EventSampler {
+public:
+    virtual ~EventSampler() = default;
+
+    /**
+     * @brief Chooses the events to process from a freshly retrieved batch.
+     * @param events The retrieved events, oldest first.
+     * @return The events to process, oldest first.
+     */
+    virtual TimedEventList select(TimedEventList events) = 0;
+
+    /**
+     * @brief Gets how many events to retrieve per call.
+     * @param configured The processor's num-events-per-retrieval.
+     * @return The number of events to ask the source for.
+     */
+    virtual size_t getRetrievalLimit(size_t configured) const { return configured; }
+
+    /**
+     * @brief Gets a short description of the policy for logging.
+     * @return The policy description.
+     */
+    virtual std::string getName() const = 0;
+
+    /**
+     * @brief Creates the sampler described by a processor's "sampling" settings.
+     * @param config Sampling configuration; "type" is "all", "every-nth", "random",
+     * "latest-only", "reservoir" or "min-interval".
+     * @return The sampler, or nullptr for "all".
+     * @throws std::invalid_argument on an unknown type or invalid settings.
+     */
+    static std::unique_ptr<EventSampler> create(const nlohmann::json& config);
+};
+
+#endif // EVENT_SAMPLER_H
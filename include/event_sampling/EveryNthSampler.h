@@ -0,0 +1,27 @@
+// EveryNthSampler.h
+#ifndef EVERY_NTH_SAMPLER_H
+#define EVERY_NTH_SAMPLER_H
+
+#include "event_sampling/EventSampler.h"
+#include <cstdint>
+
+/**
+ * @brief Keeps one event in every N, counting across batches.
+ */
+class EveryNthSampler : public EventSampler {
+public:
+    /**
+     * @brief Constructor for EveryNthSampler.
+     * @param n Keep one event in n. Must be at least 1.
+     */
+    explicit EveryNthSampler(uint64_t n);
+
+    TimedEventList select(TimedEventList events) override;
+    std::string getName() const override;
+
+private:
+    uint64_t n_; ///< Keep one event in n_.
+    uint64_t seen_ = 0; ///< Events seen so far.
+};
+
+#endif // EVERY_NTH_SAMPLER_H
@@ -0,0 +1,30 @@
+// LatestOnlySampler.h
+#ifndef LATEST_ONLY_SAMPLER_H
+#define LATEST_ONLY_SAMPLER_H
+
+#include "event_sampling/EventSampler.h"
+
+/**
+ * @brief Skips any backlog and keeps only the newest event.
+ *
+ * Drains up to scanLimit events per call so the newest one is found even when the
+ * source has fallen behind, then keeps only that one. Suited to displays, where a
+ * stale event is worth less than a missing one.
+ */
+class LatestOnlySampler : public EventSampler {
+public:
+    /**
+     * @brief Constructor for LatestOnlySampler.
+     * @param scanLimit Maximum number of events drained per call.
+     */
+    explicit LatestOnlySampler(size_t scanLimit);
+
+    TimedEventList select(TimedEventList events) override;
+    size_t getRetrievalLimit(size_t configured) const override;
+    std::string getName() const override;
+
+private:
+    size_t scanLimit_; ///< Maximum number of events drained per call.
+};
+
+#endif // LATEST_ONLY_SAMPLER_H
@@ -0,0 +1,32 @@
+// MinIntervalSampler.h
+#ifndef MIN_INTERVAL_SAMPLER_H
+#define MIN_INTERVAL_SAMPLER_H
+
+#include "event_sampling/EventSampler.h"
+#include <chrono>
+#include <unordered_map>
+
+/**
+ * @brief Keeps at most one event per event ID in each interval.
+ *
+ * An event is kept if at least the interval has passed, by receive timestamp, since
+ * the last kept event with the same event ID. Rare event types therefore still get
+ * through while a dominant trigger is thinned out.
+ */
+class MinIntervalSampler : public EventSampler {
+public:
+    /**
+     * @brief Constructor for MinIntervalSampler.
+     * @param interval Minimum time between kept events of one event ID.
+     */
+    explicit MinIntervalSampler(std::chrono::milliseconds interval);
+
+    TimedEventList select(TimedEventList events) override;
+    std::string getName() const override;
+
+private:
+    std::chrono::milliseconds interval_; ///< Minimum time between kept events of one event ID.
+    std::unordered_map<int, std::chrono::system_clock::time_point> lastKept_; ///< Last kept timestamp per event ID.
+};
+
+#endif // MIN_INTERVAL_SAMPLER_H
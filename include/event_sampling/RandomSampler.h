@@ -0,0 +1,29 @@
+// RandomSampler.h
+#ifndef RANDOM_SAMPLER_H
+#define RANDOM_SAMPLER_H
+
+#include "event_sampling/EventSampler.h"
+#include <random>
+
+/**
+ * @brief Keeps each event independently with a fixed probability.
+ */
+class RandomSampler : public EventSampler {
+public:
+    /**
+     * @brief Constructor for RandomSampler.
+     * @param fraction Probability of keeping an event, between 0 and 1.
+     * @param seed Random seed, so runs can be reproduced.
+     */
+    RandomSampler(double fraction, uint64_t seed);
+
+    TimedEventList select(TimedEventList events) override;
+    std::string getName() const override;
+
+private:
+    double fraction_; ///< Probability of keeping an event.
+    std::mt19937_64 random_; ///< Random number generator.
+    std::bernoulli_distribution keep_; ///< Draws whether to keep an event.
+};
+
+#endif // RANDOM_SAMPLER_H
@@ -0,0 +1,39 @@
+// ReservoirSampler.h
+#ifndef RESERVOIR_SAMPLER_H
+#define RESERVOIR_SAMPLER_H
+
+#include "event_sampling/EventSampler.h"
+#include <chrono>
+#include <random>
+
+/**
+ * @brief Keeps a uniform random sample of fixed size from each time window.
+ *
+ * Events are fed through a reservoir (Algorithm R) while the window is open. When it
+ * closes, the reservoir is released in arrival order and a new window starts, so
+ * every event in a window has the same chance of being kept however bursty the
+ * input is.
+ */
+class ReservoirSampler : public EventSampler {
+public:
+    /**
+     * @brief Constructor for ReservoirSampler.
+     * @param window Length of each window.
+     * @param size Number of events kept per window.
+     * @param seed Random seed, so runs can be reproduced.
+     */
+    ReservoirSampler(std::chrono::milliseconds window, size_t size, uint64_t seed);
+
+    TimedEventList select(TimedEventList events) override;
+    std::string getName() const override;
+
+private:
+    std::chrono::milliseconds window_; ///< Length of each window.
+    size_t size_; ///< Number of events kept per window.
+    std::mt19937_64 random_; ///< Random number generator.
+    std::chrono::steady_clock::time_point windowStart_; ///< When the current window opened.
+    uint64_t seenInWindow_ = 0; ///< Events offered in the current window.
+    std::vector<std::pair<uint64_t, TimedEventPtr>> reservoir_; ///< Kept events and their arrival index.
+};
+
+#endif // RESERVOIR_SAMPLER_H
@@ -0,0 +1,86 @@
+// EventHeaderFilter.h
+#ifndef EVENT_HEADER_FILTER_H
+#define EVENT_HEADER_FILTER_H
+
+#include "event_sources/EventSource.h"
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+/**
+ * @brief Settings for EventHeaderFilter. Unset criteria accept every event.
+ */
+struct EventHeaderFilterConfig {
+    std::vector<uint16_t> eventIds;          ///< Accepted event IDs; empty accepts all.
+    uint16_t triggerMask = 0;                ///< Accepts events sharing at least one trigger bit; 0 accepts all.
+    uint32_t minSerial = 0;                  ///< Smallest accepted serial number.
+    uint32_t maxSerial = std::numeric_limits<uint32_t>::max(); ///< Largest accepted serial number.
+    uint32_t minSizeBytes = 0;               ///< Smallest accepted event data size.
+    uint32_t maxSizeBytes = std::numeric_limits<uint32_t>::max(); ///< Largest accepted event data size.
+    std::vector<std::string> requiredBanks;  ///< Banks that must all be present; empty accepts all.
+
+    /**
+     * @brief Reads the settings from JSON, keeping defaults for missing keys.
+     * @param config The "filter" configuration object.
+     * @return The parsed settings.
+     */
+    static EventHeaderFilterConfig fromJson(const nlohmann::json& config);
+};
+
+/**
+ * @brief Drops events on their MIDAS header before they are unpacked.
+ *
+ * The `EventHeaderFilter` class lets several channels take different subsets of the
+ * events from the single MIDAS receiver. Header fields are checked first; bank
+ * presence, the only check that has to look past the header, is checked last by
+ * reading the bank headers in place; events are shared and are never modified.
+ */
+class EventHeaderFilter {
+public:
+    /**
+     * @brief Constructor for EventHeaderFilter.
+     * @param config The filter settings.
+     */
+    explicit EventHeaderFilter(const EventHeaderFilterConfig& config);
+
+    /**
+     * @brief Checks if an event passes every criterion.
+     * @param event The event.
+     * @return True if accepted, false otherwise.
+     */
+    bool accepts(const TMEvent& event) const;
+
+    /**
+     * @brief Removes the events that do not pass.
+     * @param events The events, oldest first.
+     * @return The accepted events, oldest first.
+     */
+    TimedEventList apply(TimedEventList events) const;
+
+    /**
+     * @brief Checks if any criterion is set.
+     * @return True if the filter can reject events, false if it accepts everything.
+     */
+    bool isActive() const;
+
+    /**
+     * @brief Gets a short description of the criteria for logging.
+     * @return The description.
+     */
+    std::string describe() const;
+
+private:
+    EventHeaderFilterConfig config_; ///< The filter settings.
+
+    /**
+     * @brief Checks if an event contains a bank, without modifying the event.
+     * @param event The event.
+     * @param name The four-character bank name.
+     * @return True if the bank is present, false otherwise.
+     */
+    static bool hasBank(const TMEvent& event, const std::string& name);
+};
+
+#endif // EVENT_HEADER_FILTER_H
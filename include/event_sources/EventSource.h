@@ -0,0 +1,87 @@
+// EventSource.h
+#ifndef EVENT_SOURCE_H
+#define EVENT_SOURCE_H
+
+#include "receivers/MidasReceiverInterface.h"
+#include "midasio.h"
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Wraps a TMEvent the same way MidasReceiver does.
+ * @param event The event to wrap.
+ * @param timestamp Receive timestamp to attach.
+ * @return The timed event.
+ */
+inline TimedEventPtr makeTimedEvent(TMEvent&& event, std::chrono::system_clock::time_point timestamp) {
+    auto timedEvent = std::make_shared<TimedEventType>();
+    timedEvent->event = std::move(event);
+    timedEvent->timestamp = timestamp;
+    return timedEvent;
+}
+
+/**
+ * @brief Gets the TMEvent held by a timed event.
+ * @param timedEvent The timed event.
+ * @return Reference to the wrapped TMEvent.
+ */
+inline const TMEvent& eventOf(const TimedEventType& timedEvent) {
+    return timedEvent.event;
+}
+
+/**
+ * @brief An abstract source of MIDAS events for MidasEventProcessor.
+ *
+ * The `EventSource` class hides where events come from, so the unpacking pipeline
+ * and publish path can be driven by a live experiment, a recorded run or a
+ * synthetic generator alike. Each source keeps its own read cursor.
+ */
+class EventSource {
+public:
+    virtual ~EventSource() = default;
+
+    /**
+     * @brief Gets the events that became available since the previous call.
+     * @param maxEvents Maximum number of events to return.
+     * @return The new events, oldest first.
+     */
+    virtual TimedEventList getLatestEvents(size_t maxEvents) = 0;
+
+    /**
+     * @brief Checks if the source has no more events to deliver.
+     * @return True once a finite source has been fully consumed.
+     */
+    virtual bool isExhausted() const { return false; }
+
+    /**
+     * @brief Gets the run number the current events belong to, if the source knows it.
+     * @return The run number, or -1 if unknown.
+     */
+    virtual INT getRunNumber() const { return -1; }
+
+    /**
+     * @brief Gets the number of events the source passed over for its header filter.
+     * @return The number of events, 0 for sources without a filter.
+     */
+    virtual uint64_t getFilteredCount() const { return 0; }
+
+    /**
+     * @brief Gets a short description of the source for logging.
+     * @return The source description.
+     */
+    virtual std::string getName() const = 0;
+
+    /**
+     * @brief Creates an event source that does not need a MIDAS receiver.
+     * @param config Source configuration; "type" is "file" or "synthetic".
+     * @return The event source.
+     * @throws std::invalid_argument on an unknown type or missing settings.
+     */
+    static std::unique_ptr<EventSource> createOffline(const nlohmann::json& config);
+};
+
+#endif // EVENT_SOURCE_H
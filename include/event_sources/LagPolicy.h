@@ -0,0 +1,46 @@
+// LagPolicy.h
+#ifndef LAG_POLICY_H
+#define LAG_POLICY_H
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <nlohmann/json.hpp>
+
+/**
+ * @brief How a live event source catches up after falling behind the receiver.
+ */
+enum class LagMode {
+    Latest,  ///< Skip the backlog and take only the newest events.
+    All,     ///< Take every event, in larger batches while behind.
+    Bounded  ///< Take every event unless the lag exceeds a limit, then skip the oldest.
+};
+
+/**
+ * @brief Settings for catching up on a live event backlog.
+ *
+ * Configured as "lag-policy" in the event source settings. Without it every event is
+ * taken at the normal retrieval size, as before.
+ */
+struct LagPolicy {
+    LagMode mode = LagMode::All;          ///< How to catch up.
+    size_t maxLagEvents = 0;              ///< Bounded: most unread events kept; 0 for no limit.
+    std::chrono::milliseconds maxLagMs{0}; ///< Bounded: oldest unread event kept; 0 for no limit.
+    size_t catchUpBatch = 0;              ///< All: events taken per call while behind; 0 for the normal size.
+
+    /**
+     * @brief Reads the settings from JSON, keeping defaults for missing keys.
+     * @param config The "lag-policy" configuration object.
+     * @return The parsed settings.
+     * @throws std::invalid_argument on an unknown mode or a bounded mode without limits.
+     */
+    static LagPolicy fromJson(const nlohmann::json& config);
+
+    /**
+     * @brief Gets a short description of the policy for logging.
+     * @return The description.
+     */
+    std::string describe() const;
+};
+
+#endif // LAG_POLICY_H
@@ -0,0 +1,41 @@
+// LiveEventSource.h
+#ifndef LIVE_EVENT_SOURCE_H
+#define LIVE_EVENT_SOURCE_H
+
+#include "event_sources/EventSource.h"
+#include "event_sources/EventHeaderFilter.h"
+#include "event_sources/LagPolicy.h"
+#include "receivers/EventFanOut.h"
+#include <memory>
+
+/**
+ * @brief Event source reading from a MIDAS receiver, real or stand-in.
+ *
+ * Events come through the receiver's EventFanOut, so every live source shares a
+ * single receive. The receiver must be initialized and started by the owner. After a
+ * stall, the LagPolicy decides whether the backlog is skipped or worked through.
+ * Events rejected by the header filter are passed over as they are taken, so only
+ * accepted events count toward each call's limit.
+ */
+class LiveEventSource : public EventSource {
+public:
+    /**
+     * @brief Constructor for LiveEventSource.
+     * @param consumer The fan-out consumer to take events from.
+     * @param lagPolicy How to catch up when behind.
+     * @param filter Header filter applied while taking events, or nullptr.
+     */
+    explicit LiveEventSource(std::shared_ptr<EventConsumer> consumer, const LagPolicy& lagPolicy = LagPolicy(),
+                             std::shared_ptr<const EventHeaderFilter> filter = nullptr);
+
+    TimedEventList getLatestEvents(size_t maxEvents) override;
+    uint64_t getFilteredCount() const override;
+    std::string getName() const override;
+
+private:
+    std::shared_ptr<EventConsumer> consumer_; ///< Fan-out consumer events are taken from.
+    LagPolicy lagPolicy_; ///< How to catch up when behind.
+    std::shared_ptr<const EventHeaderFilter> filter_; ///< Header filter, or nullptr.
+};
+
+#endif // LIVE_EVENT_SOURCE_H
@@ -0,0 +1,66 @@
+// MidasFileEventSource.h
+#ifndef MIDAS_FILE_EVENT_SOURCE_H
+#define MIDAS_FILE_EVENT_SOURCE_H
+
+#include "event_sources/EventSource.h"
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Event source replaying `.mid` / `.mid.gz` files through the midasio reader.
+ *
+ * Files are read in the given order. Begin- and end-of-run ODB dumps are skipped,
+ * but their serial number is used as the run number. Events are released either as
+ * fast as they are requested or at their original pace, scaled by a speed factor.
+ * The MIDAS event header only stores whole seconds, so paced replay releases each
+ * second's events together. Each pass of a looping replay is paced from its own
+ * first event.
+ */
+class MidasFileEventSource : public EventSource {
+public:
+    /**
+     * @brief Constructor for MidasFileEventSource.
+     * @param files Paths of the files to replay, in order.
+     * @param speed Playback speed relative to the original timing; 0 replays as fast as possible.
+     * @param loop Whether to start over from the first file after the last one.
+     */
+    MidasFileEventSource(const std::vector<std::string>& files, double speed, bool loop);
+    ~MidasFileEventSource() override;
+
+    TimedEventList getLatestEvents(size_t maxEvents) override;
+    bool isExhausted() const override;
+    INT getRunNumber() const override;
+    std::string getName() const override;
+
+private:
+    std::vector<std::string> files_; ///< Files to replay.
+    size_t fileIndex_; ///< Index of the next file to open.
+    TMReaderInterface* reader_; ///< Reader for the current file, if any.
+    double speed_; ///< Playback speed; 0 means maximum speed.
+    bool loop_; ///< Whether to restart after the last file.
+    bool exhausted_; ///< Set once every file has been read and looping is off.
+    INT runNumber_; ///< Run number from the last begin-of-run event.
+
+    std::unique_ptr<TMEvent> pending_; ///< Event read ahead that is not due yet.
+    bool haveFirstEvent_; ///< Whether the pacing reference has been set.
+    uint32_t firstEventTime_; ///< MIDAS time stamp of the first event of the current pass.
+    std::chrono::steady_clock::time_point replayStart_; ///< Wall time the first event of the current pass was released.
+
+    /**
+     * @brief Reads the next data event, moving on to the next file as needed.
+     * @return The event, or nullptr when there are no more events.
+     */
+    std::unique_ptr<TMEvent> readNext();
+
+    /**
+     * @brief Opens the next file in the list.
+     * @return True if a file was opened, false if none are left.
+     */
+    bool openNextFile();
+
+    void closeReader();
+};
+
+#endif // MIDAS_FILE_EVENT_SOURCE_H
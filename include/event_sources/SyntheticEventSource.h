@@ -0,0 +1,71 @@
+// SyntheticEventSource.h
+#ifndef SYNTHETIC_EVENT_SOURCE_H
+#define SYNTHETIC_EVENT_SOURCE_H
+
+#include "event_sources/EventSource.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+/**
+ * @brief Settings for SyntheticEventSource.
+ */
+struct SyntheticEventConfig {
+    double rateHz = 0;            ///< Event rate; 0 generates as many events as requested.
+    uint16_t eventId = 1;         ///< Event ID of generated events.
+    uint16_t triggerMask = 0;     ///< Trigger mask of generated events.
+    size_t numBanks = 1;          ///< Number of banks per event.
+    size_t bankSizeBytes = 1024;  ///< Payload size of each bank, rounded up to whole 32-bit words.
+    INT runNumber = 0;            ///< Run number reported for generated events.
+    uint64_t maxEvents = 0;       ///< Total events to generate; 0 is unlimited.
+    size_t maxBacklog = 1000;     ///< Events allowed to pile up at a fixed rate before the oldest are dropped.
+    uint64_t seed = 1;            ///< Seed for the bank contents.
+
+    /**
+     * @brief Reads the settings from JSON, keeping defaults for missing keys.
+     * @param config The "event-source" configuration object.
+     * @return The parsed settings.
+     */
+    static SyntheticEventConfig fromJson(const nlohmann::json& config);
+};
+
+/**
+ * @brief Event source generating MIDAS events with random bank contents.
+ *
+ * Events are built with TMEvent::AddBank, so they unpack exactly like real ones.
+ * At a fixed rate, events that the consumer has not picked up pile up like in a
+ * receiver buffer and are dropped (and counted) beyond the configured backlog.
+ */
+class SyntheticEventSource : public EventSource {
+public:
+    /**
+     * @brief Constructor for SyntheticEventSource.
+     * @param config The generator settings.
+     */
+    explicit SyntheticEventSource(const SyntheticEventConfig& config);
+
+    TimedEventList getLatestEvents(size_t maxEvents) override;
+    bool isExhausted() const override;
+    INT getRunNumber() const override;
+    std::string getName() const override;
+
+    /**
+     * @brief Gets the number of events dropped because the backlog overflowed.
+     * @return The number of dropped events.
+     */
+    uint64_t getDroppedCount() const;
+
+private:
+    SyntheticEventConfig config_; ///< Generator settings.
+    uint64_t generated_; ///< Events generated (or dropped) so far; also the next serial number.
+    uint64_t dropped_; ///< Events dropped because the backlog overflowed.
+    uint64_t rngState_; ///< xorshift state for bank contents.
+    std::vector<uint32_t> bankData_; ///< Scratch buffer for one bank.
+    std::chrono::steady_clock::time_point start_; ///< Reference time for fixed-rate generation.
+
+    TMEvent generateEvent();
+};
+
+#endif // SYNTHETIC_EVENT_SOURCE_H
@@ -0,0 +1,165 @@
+// EventTracer.h
+#ifndef EVENT_TRACER_H
+#define EVENT_TRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Samples events and records how long each spends in every publisher stage.
+ *
+ * When enabled, one event in N is given a trace id. Each stage it passes through
+ * (receiver buffering, pipeline execution, product serialization, buffer serialization,
+ * zmq send) is recorded as a span on the monotonic clock into a fixed-size lock-free
+ * ring, overwriting the oldest spans. The ring is written out in the Chrome trace event
+ * format, which chrome://tracing and ui.perfetto.dev open directly; every sampled event
+ * gets its own track.
+ *
+ * Per-event stages are recorded with the trace id directly. Per-publish stages apply to
+ * every sampled event being published, so producers open the trace on the publishing
+ * thread and the channel closes the thread's open traces once they have been sent.
+ *
+ * When disabled, the cost is one relaxed atomic load per event.
+ */
+class EventTracer {
+public:
+    /**
+     * @brief Gets the singleton instance of EventTracer.
+     * @return Reference to the singleton instance.
+     */
+    static EventTracer& Instance();
+
+    /**
+     * @brief Enables tracing.
+     * @param sampleEvery Trace one event in this many (1 traces everything).
+     * @param capacity Number of spans kept, rounded up to a power of two.
+     * @details Call once, before events flow.
+     */
+    void enable(uint64_t sampleEvery, size_t capacity);
+
+    /**
+     * @brief Checks if tracing is enabled.
+     * @return True if enabled, false otherwise.
+     */
+    bool isEnabled() const {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Decides whether to trace the next event and, if so, opens its trace on this thread.
+     * @return The trace id, or 0 if the event is not traced.
+     */
+    uint64_t sampleEvent();
+
+    /**
+     * @brief Records a stage of one traced event.
+     * @param traceId The trace id; 0 records nothing.
+     * @param stage The stage name. Must outlive the tracer (use a string literal).
+     * @param startNs Start on the monotonic clock, see now().
+     * @param endNs End on the monotonic clock.
+     */
+    void record(uint64_t traceId, const char* stage, int64_t startNs, int64_t endNs);
+
+    /**
+     * @brief Records a stage for every trace open on this thread.
+     * @param stage The stage name. Must outlive the tracer (use a string literal).
+     * @param startNs Start on the monotonic clock.
+     * @param endNs End on the monotonic clock.
+     */
+    void recordOpen(const char* stage, int64_t startNs, int64_t endNs);
+
+    /**
+     * @brief Checks if this thread has open traces.
+     * @return True if recordOpen() would record anything.
+     */
+    bool hasOpenTraces() const;
+
+    /**
+     * @brief Closes the traces open on this thread.
+     */
+    void closeOpenTraces();
+
+    /**
+     * @brief Writes the recorded spans as Chrome trace JSON.
+     * @param path The output file.
+     * @return The number of spans written, or -1 on failure.
+     */
+    long dump(const std::string& path) const;
+
+    /**
+     * @brief Current time on the monotonic clock used for spans.
+     * @return Nanoseconds since an arbitrary epoch.
+     */
+    static int64_t now() {
+        return toNanoseconds(std::chrono::steady_clock::now());
+    }
+
+    /**
+     * @brief Converts a steady-clock time point to span time.
+     * @param time The time point.
+     * @return Nanoseconds since the steady clock's epoch.
+     */
+    static int64_t toNanoseconds(std::chrono::steady_clock::time_point time) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    }
+
+private:
+    /**
+     * @brief One span. Fields are atomics so a concurrent dump never reads torn values.
+     */
+    struct Slot {
+        std::atomic<uint64_t> sequence{0}; ///< Odd while being written, 2 * ticket + 2 when complete.
+        std::atomic<uint64_t> traceId{0};
+        std::atomic<const char*> stage{nullptr};
+        std::atomic<int64_t> startNs{0};
+        std::atomic<int64_t> durationNs{0};
+    };
+
+    std::atomic<bool> enabled_{false}; ///< Set by enable().
+    uint64_t sampleEvery_ = 1; ///< Sampling period.
+    std::atomic<uint64_t> eventsSeen_{0}; ///< Events offered to sampleEvent().
+    std::atomic<uint64_t> nextTraceId_{1}; ///< Next trace id to hand out.
+    std::unique_ptr<Slot[]> slots_; ///< The ring.
+    size_t mask_ = 0; ///< Ring size minus one.
+    std::atomic<uint64_t> head_{0}; ///< Next ticket; the slot is ticket & mask_.
+
+    static thread_local std::vector<uint64_t> openTraces_; ///< Traces sampled but not yet published on this thread.
+
+    EventTracer() = default;
+    EventTracer(const EventTracer&) = delete;
+    EventTracer& operator=(const EventTracer&) = delete;
+};
+
+/**
+ * @brief Records one stage of a traced event for the lifetime of the scope.
+ */
+class TraceSpan {
+public:
+    /**
+     * @brief Starts the span.
+     * @param traceId The trace id; 0 makes the span a no-op.
+     * @param stage The stage name (a string literal).
+     */
+    TraceSpan(uint64_t traceId, const char* stage)
+        : traceId_(traceId), stage_(stage), startNs_(traceId ? EventTracer::now() : 0) {}
+
+    ~TraceSpan() {
+        if (traceId_) {
+            EventTracer::Instance().record(traceId_, stage_, startNs_, EventTracer::now());
+        }
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    uint64_t traceId_; ///< The traced event, or 0.
+    const char* stage_; ///< The stage name.
+    int64_t startNs_; ///< Start on the monotonic clock.
+};
+
+#endif // EVENT_TRACER_H
@@ -0,0 +1,182 @@
+// Metrics.h
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief A monotonically increasing count, safe to bump from any thread.
+ */
+class Counter {
+public:
+    /**
+     * @brief Adds to the counter.
+     * @param amount The amount to add (default is 1).
+     */
+    void add(uint64_t amount = 1) {
+        value_.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Gets the current count.
+     * @return The count.
+     */
+    uint64_t get() const {
+        return value_.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint64_t> value_{0}; ///< The count.
+};
+
+/**
+ * @brief A value that can go up and down, safe to set from any thread.
+ */
+class Gauge {
+public:
+    /**
+     * @brief Sets the gauge.
+     * @param value The new value.
+     */
+    void set(int64_t value) {
+        value_.store(value, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Adds to the gauge.
+     * @param amount The amount to add, may be negative.
+     */
+    void add(int64_t amount) {
+        value_.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Gets the current value.
+     * @return The value.
+     */
+    int64_t get() const {
+        return value_.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<int64_t> value_{0}; ///< The value.
+};
+
+/**
+ * @brief A copy of a histogram's buckets, for quantiles over a time window.
+ */
+struct HistogramSnapshot {
+    std::vector<uint64_t> counts; ///< Counts per bucket.
+    uint64_t count = 0; ///< Number of values.
+    uint64_t sum = 0; ///< Sum of values.
+
+    /**
+     * @brief Gets the values recorded between an earlier snapshot and this one.
+     * @param earlier The earlier snapshot of the same histogram (may be empty).
+     * @return The difference.
+     */
+    HistogramSnapshot since(const HistogramSnapshot& earlier) const;
+
+    /**
+     * @brief Gets the value at a quantile.
+     * @param quantile The quantile, between 0 and 1.
+     * @return The upper bound of the bucket holding the quantile, or 0 if empty.
+     */
+    uint64_t quantile(double quantile) const;
+
+    /**
+     * @brief Gets the upper bound of the highest non-empty bucket.
+     * @return The bound, or 0 if empty.
+     */
+    uint64_t max() const;
+};
+
+/**
+ * @brief A lock-free log-linear histogram in the style of HdrHistogram.
+ *
+ * Values are counted in buckets that are exact below 64 and, above that, split each
+ * power of two into 32 equal sub-buckets, so any recorded value is reproduced within
+ * about 3%. Values up to 2^41 (about 36 minutes in nanoseconds) are resolved; larger
+ * values land in the last bucket. Recording is a handful of relaxed atomic adds.
+ */
+class Histogram {
+public:
+    static constexpr unsigned SUB_BUCKET_BITS = 5; ///< log2 of the sub-buckets per power of two.
+    static constexpr unsigned MAX_EXPONENT = 40; ///< Highest resolved power of two.
+    static constexpr size_t NUM_BUCKETS = (size_t(1) << SUB_BUCKET_BITS) * (MAX_EXPONENT - SUB_BUCKET_BITS + 2);
+
+    /**
+     * @brief Records one value.
+     * @param value The value, e.g. a duration in nanoseconds.
+     */
+    void record(uint64_t value);
+
+    /**
+     * @brief Gets the number of recorded values.
+     * @return The count.
+     */
+    uint64_t getCount() const;
+
+    /**
+     * @brief Gets the sum of recorded values.
+     * @return The sum.
+     */
+    uint64_t getSum() const;
+
+    /**
+     * @brief Gets the largest recorded value.
+     * @return The maximum, or 0 if nothing was recorded.
+     */
+    uint64_t getMax() const;
+
+    /**
+     * @brief Gets the value at a quantile.
+     * @param quantile The quantile, between 0 and 1.
+     * @return The upper bound of the bucket holding the quantile (capped at the maximum),
+     * or 0 if nothing was recorded.
+     */
+    uint64_t getQuantile(double quantile) const;
+
+    /**
+     * @brief Copies the buckets.
+     * @return The snapshot. Buckets are read one by one while writers may still add.
+     */
+    HistogramSnapshot snapshot() const;
+
+    /**
+     * @brief Maps a value to its bucket.
+     * @param value The value.
+     * @return The bucket index.
+     */
+    static size_t bucketIndex(uint64_t value);
+
+    /**
+     * @brief Gets the highest value that maps to a bucket.
+     * @param index The bucket index.
+     * @return The bucket's upper bound.
+     */
+    static uint64_t bucketUpperBound(size_t index);
+
+private:
+    std::array<std::atomic<uint64_t>, NUM_BUCKETS> buckets_{}; ///< Counts per bucket.
+    std::atomic<uint64_t> count_{0}; ///< Number of recorded values.
+    std::atomic<uint64_t> sum_{0}; ///< Sum of recorded values.
+    std::atomic<uint64_t> max_{0}; ///< Largest recorded value.
+};
+
+/**
+ * @brief Nanoseconds elapsed since a steady-clock time point.
+ * @param start The start time.
+ * @return The elapsed time in nanoseconds.
+ */
+inline uint64_t elapsedNanoseconds(std::chrono::steady_clock::time_point start) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+#endif // METRICS_H
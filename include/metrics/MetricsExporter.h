@@ -0,0 +1,59 @@
+// MetricsExporter.h
+#ifndef METRICS_EXPORTER_H
+#define METRICS_EXPORTER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @brief Periodically writes the MetricsRegistry to disk.
+ *
+ * The `MetricsExporter` class runs a background thread that dumps every metric as JSON
+ * and/or as a Prometheus textfile (for node_exporter's textfile collector). Files are
+ * written to a temporary name and renamed, so readers never see a partial dump. A
+ * final dump is written when the exporter stops.
+ */
+class MetricsExporter {
+public:
+    /**
+     * @brief Constructor for MetricsExporter. Starts the export thread.
+     * @param jsonFile Path of the JSON dump, or empty to skip it.
+     * @param prometheusFile Path of the Prometheus textfile, or empty to skip it.
+     * @param interval Time between dumps.
+     */
+    MetricsExporter(const std::string& jsonFile, const std::string& prometheusFile, std::chrono::milliseconds interval);
+
+    /**
+     * @brief Destructor for MetricsExporter. Stops the thread after a final dump.
+     */
+    ~MetricsExporter();
+
+    /**
+     * @brief Writes the configured files now.
+     * @return True if every file was written, false otherwise.
+     */
+    bool exportNow();
+
+    /**
+     * @brief Stops the export thread after a final dump.
+     */
+    void stop();
+
+private:
+    std::string jsonFile_; ///< Path of the JSON dump.
+    std::string prometheusFile_; ///< Path of the Prometheus textfile.
+    std::chrono::milliseconds interval_; ///< Time between dumps.
+
+    std::mutex mutex_; ///< Guards stopping_.
+    std::condition_variable wakeUp_; ///< Signalled on stop.
+    bool stopping_; ///< Set when the thread should exit.
+    std::thread thread_; ///< Export thread.
+
+    void run();
+    static bool writeAtomically(const std::string& path, const std::string& contents);
+};
+
+#endif // METRICS_EXPORTER_H
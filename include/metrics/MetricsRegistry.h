@@ -0,0 +1,184 @@
+// MetricsRegistry.h
+#ifndef METRICS_REGISTRY_H
+#define METRICS_REGISTRY_H
+
+#include "metrics/Metrics.h"
+#include <nlohmann/json.hpp>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Label names and values distinguishing the series of one metric.
+ */
+using MetricLabels = std::map<std::string, std::string>;
+
+/**
+ * @brief The metrics every data channel reports.
+ */
+struct ChannelMetrics {
+    std::string channel; ///< The channel name.
+    Counter* messagesPublished; ///< Messages handed to zmq.
+    Counter* bytesPublished; ///< Payload bytes handed to zmq.
+    Counter* messagesSkipped; ///< Publishes skipped while the channel was on a break.
+    Counter* messagesRateLimited; ///< Publishes skipped by the channel's rate control.
+    Counter* sendErrors; ///< Publishes that failed in zmq.
+    Counter* entriesOverwritten; ///< Buffered entries overwritten before they were ever published.
+    Gauge* bufferDepth; ///< Entries in the channel's circular buffer.
+    Histogram* serializationTime; ///< Time to serialize the buffer, in nanoseconds.
+    Histogram* sendTime; ///< Time to hand a message to zmq, in nanoseconds.
+    Counter* publishesShed; ///< Loops the channel sat out to shed load.
+    Counter* latencyBudgetMisses; ///< Publishes that took longer than the channel's latency budget.
+    Gauge* bufferBytes; ///< Payload bytes in the channel's circular buffer.
+    Gauge* bufferPeakBytes; ///< Most payload bytes ever held in the channel's circular buffer.
+    Counter* entriesEvicted; ///< Buffered entries evicted to stay within the byte budget.
+};
+
+/**
+ * @brief The metrics every processor reports.
+ */
+struct ProcessorMetrics {
+    std::string channel; ///< The name of the channel the processor belongs to.
+    std::string processor; ///< The processor type.
+    size_t index; ///< The processor's position in the channel.
+    Counter* runs; ///< Calls to getProcessedOutput.
+    Counter* outputs; ///< Entries produced.
+    Counter* outputBytes; ///< Bytes produced.
+    Histogram* processingTime; ///< Time spent in getProcessedOutput, in nanoseconds.
+    Counter* deadlineMisses; ///< Runs that took longer than the processor's latency budget.
+    Counter* runsShed; ///< Due runs skipped to shed load.
+    Counter* outputsSuppressed; ///< Entries left out by publish-on-change for being unchanged.
+};
+
+/**
+ * @brief The metrics of the main publish loop.
+ */
+struct LoopMetrics {
+    Histogram* duration; ///< Time to publish all channels once, in nanoseconds.
+    Counter* deadlineMisses; ///< Loops that took longer than the tick time.
+};
+
+/**
+ * @brief Process-wide registry of counters, gauges and histograms.
+ *
+ * Metrics are looked up by name and labels once, at setup, and the returned
+ * references stay valid for the lifetime of the program. Updating them is
+ * lock-free; only registration and export take the registry lock.
+ *
+ * Histograms record raw integers. A scale given at registration converts them
+ * on export, e.g. 1e-9 to export nanosecond durations as seconds.
+ */
+class MetricsRegistry {
+public:
+    /**
+     * @brief Gets the singleton instance of MetricsRegistry.
+     * @return Reference to the singleton instance.
+     */
+    static MetricsRegistry& Instance();
+
+    /**
+     * @brief Gets or creates a counter.
+     * @param name The metric name.
+     * @param help One line describing the metric.
+     * @param labels The series labels.
+     * @return The counter.
+     * @throws std::invalid_argument If the name is already registered with another type.
+     */
+    Counter& counter(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+
+    /**
+     * @brief Gets or creates a gauge.
+     * @param name The metric name.
+     * @param help One line describing the metric.
+     * @param labels The series labels.
+     * @return The gauge.
+     * @throws std::invalid_argument If the name is already registered with another type.
+     */
+    Gauge& gauge(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+
+    /**
+     * @brief Gets or creates a histogram.
+     * @param name The metric name.
+     * @param help One line describing the metric.
+     * @param labels The series labels.
+     * @param exportScale Factor applied to recorded values on export (default is 1).
+     * @return The histogram.
+     * @throws std::invalid_argument If the name is already registered with another type.
+     */
+    Histogram& histogram(const std::string& name, const std::string& help, const MetricLabels& labels = {},
+                         double exportScale = 1.0);
+
+    /**
+     * @brief Gets the metrics of a data channel.
+     * @param channel The channel name.
+     * @return The channel's metrics.
+     */
+    ChannelMetrics& channel(const std::string& channel);
+
+    /**
+     * @brief Gets the metrics of a processor.
+     * @param channel The name of the channel the processor belongs to.
+     * @param processor The processor type.
+     * @param index The processor's position in the channel.
+     * @return The processor's metrics.
+     */
+    ProcessorMetrics& processor(const std::string& channel, const std::string& processor, size_t index);
+
+    /**
+     * @brief Gets the metrics of the main publish loop.
+     * @return The loop metrics.
+     */
+    LoopMetrics& loop();
+
+    /**
+     * @brief Gets every channel metric set registered so far.
+     * @return The channel metrics, ordered by channel name.
+     */
+    std::vector<const ChannelMetrics*> getChannels() const;
+
+    /**
+     * @brief Gets every processor metric set registered so far.
+     * @return The processor metrics, ordered by channel and position.
+     */
+    std::vector<const ProcessorMetrics*> getProcessors() const;
+
+    /**
+     * @brief Renders all metrics as JSON, with quantiles for histograms.
+     * @return The metrics.
+     */
+    nlohmann::json toJson() const;
+
+    /**
+     * @brief Renders all metrics in the Prometheus text exposition format.
+     * @return The metrics. Histograms are exported as summaries.
+     */
+    std::string toPrometheus() const;
+
+private:
+    enum class Type { Counter, Gauge, Histogram };
+
+    struct Family {
+        Type type;
+        std::string help;
+        double exportScale = 1.0;
+        std::map<MetricLabels, std::unique_ptr<Counter>> counters;
+        std::map<MetricLabels, std::unique_ptr<Gauge>> gauges;
+        std::map<MetricLabels, std::unique_ptr<Histogram>> histograms;
+    };
+
+    mutable std::mutex mutex_; ///< Guards the maps, not the metrics.
+    std::map<std::string, Family> families_; ///< Metrics by name.
+    std::map<std::string, std::unique_ptr<ChannelMetrics>> channels_; ///< Channel metric sets by channel.
+    std::map<std::string, std::unique_ptr<ProcessorMetrics>> processors_; ///< Processor metric sets by channel/index.
+    std::unique_ptr<LoopMetrics> loop_; ///< Main loop metrics, created on first use.
+
+    MetricsRegistry() = default;
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    Family& family(const std::string& name, const std::string& help, Type type);
+};
+
+#endif // METRICS_REGISTRY_H
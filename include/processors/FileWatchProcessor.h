@@ -0,0 +1,111 @@
+// FileWatchProcessor.h
+#ifndef FILE_WATCH_PROCESSOR_H
+#define FILE_WATCH_PROCESSOR_H
+
+#include "processors/GeneralProcessor.h"
+#include "utilities/RecordSplitter.h"
+#include <chrono>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+#include <nlohmann/json.hpp>
+
+/**
+ * @brief A processor that publishes what is appended to files, as it is appended.
+ *
+ * The `FileWatchProcessor` class replaces running `cat` or `tail` through a
+ * `CommandProcessor`. It watches the directories of its files with inotify and only
+ * touches a file after the kernel reported a change to it, reading from the offset
+ * where it left off. While the files are idle, a period costs one poll of the inotify
+ * descriptor and the processor does not run at all; changes to other files in the same
+ * directories only cost a run that reads nothing. Every record, by default a line,
+ * becomes one buffer entry.
+ *
+ * A file that is replaced, by rename as logrotate does or by being deleted and created
+ * again, is read to its end and then followed from the start of the new file. A file
+ * that shrinks, as with copytruncate, is read again from the start.
+ *
+ * @code
+ * { "processor": "FileWatchProcessor", "period-ms": 100,
+ *   "files": ["/var/log/messages", "/run/daq/status.txt"], "from-start": false,
+ *   "delimiter": "\n", "max-record-bytes": 1048576, "max-read-bytes": 16777216 }
+ * @endcode
+ */
+class FileWatchProcessor : public GeneralProcessor {
+public:
+    explicit FileWatchProcessor(int verbose = 0);
+    ~FileWatchProcessor() override;
+
+    FileWatchProcessor(const FileWatchProcessor&) = delete;
+    FileWatchProcessor& operator=(const FileWatchProcessor&) = delete;
+
+    /**
+     * @brief Reads the files and settings and starts watching.
+     * @param config The processor configuration.
+     * @throws std::invalid_argument if no file is given.
+     * @throws std::runtime_error if inotify is not available.
+     */
+    void Init(const nlohmann::json& config);
+
+    std::vector<std::string> getProcessedOutput() override;
+    bool isReadyToProcess() const override;
+
+private:
+    /**
+     * @brief A watched file and how far it has been read.
+     */
+    struct WatchedFile {
+        std::string path; ///< The path as configured.
+        std::string name; ///< The file name within its directory, as inotify reports it.
+        int watch = -1; ///< inotify watch descriptor of its directory.
+        int fd = -1; ///< The open file, or -1 if it does not exist.
+        dev_t device = 0; ///< Device of the open file.
+        ino_t inode = 0; ///< Inode of the open file, to recognize a replacement.
+        off_t offset = 0; ///< Bytes of the open file read so far.
+        bool changed = false; ///< Whether inotify reported a change since the last read.
+        RecordSplitter records; ///< Cuts the file's data into records.
+    };
+
+    int inotifyFd_ = -1; ///< The inotify descriptor.
+    std::vector<WatchedFile> files_; ///< The watched files.
+    bool fromStart_ = false; ///< Whether files found at startup are read from the start.
+    size_t maxReadBytes_ = 16777216; ///< Most bytes read from one file per run; the rest follows next run.
+    bool backlog_ = false; ///< Whether a file was left unfinished at maxReadBytes_.
+    std::chrono::steady_clock::time_point lastProcessedTime_; ///< When the files were last read.
+
+    /**
+     * @brief Reads pending inotify events and marks the files they are about as changed.
+     * @return True if any file changed, false otherwise.
+     */
+    bool readEvents();
+
+    /**
+     * @brief Reads what was appended to a file since the last read, following a replacement.
+     * @param file The file.
+     * @param out The entries to append records to.
+     */
+    void readFile(WatchedFile& file, std::vector<std::string>& out);
+
+    /**
+     * @brief Reads a file from its offset to its end, or to maxReadBytes_, into its record splitter.
+     * @param file The file.
+     * @return True if the end was reached, false otherwise.
+     */
+    bool readToEnd(WatchedFile& file);
+
+    /**
+     * @brief Opens the file at the file's path, if there is one.
+     * @param file The file.
+     * @param atEnd Whether to start reading at its end instead of its start.
+     * @return True if it was opened, false otherwise.
+     */
+    bool openFile(WatchedFile& file, bool atEnd);
+
+    /**
+     * @brief Closes a file, so it is opened again once it exists.
+     * @param file The file.
+     */
+    void closeFile(WatchedFile& file);
+};
+
+#endif // FILE_WATCH_PROCESSOR_H
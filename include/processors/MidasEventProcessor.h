@@ -3,9 +3,13 @@
 #define MIDAS_EVENT_PROCESSOR_H
 
 #include "processors/GeneralProcessor.h"
-#include "MidasReceiver.h"
+#include "receivers/MidasReceiverInterface.h"
 #include "analysis_pipeline/pipeline/pipeline.h"
 #include "analysis_pipeline/config/config_manager.h"
+#include "utilities/JsonWriter.h"
+#include "event_sources/EventSource.h"
+#include "event_sources/EventHeaderFilter.h"
+#include "event_sampling/EventSampler.h"
 #include <chrono>
 #include <nlohmann/json.hpp>
 #include <unordered_set>
@@ -15,9 +19,17 @@ public:
     explicit MidasEventProcessor(int verbose = 0);
     ~MidasEventProcessor() override;
 
+    /**
+     * @brief Sets up the event source and the analysis pipeline.
+     * @param midas_receiver_config Settings for the MIDAS receiver.
+     * @param pipeline_config The analysis pipeline configuration.
+     * @param midas_event_processor_config Event source, filter and sampling settings.
+     * @param default_consumer_name Fan-out consumer name unless the event source sets "consumer-name".
+     */
     void Init(const nlohmann::json& midas_receiver_config,
               const nlohmann::json& pipeline_config,
-              const nlohmann::json& midas_event_processor_config);
+              const nlohmann::json& midas_event_processor_config,
+              const std::string& default_consumer_name = "MidasEventProcessor");
 
     std::vector<std::string> getProcessedOutput() override;
     bool isReadyToProcess() const override;
@@ -25,19 +37,33 @@ public:
 private:
     std::chrono::system_clock::time_point lastProcessedTime_;
 
-    MidasReceiver& midasReceiver_;
-    std::chrono::system_clock::time_point lastEventTimestamp_;
+    MidasReceiverInterface& midasReceiver_;
+    std::unique_ptr<EventSource> eventSource_;
+    std::shared_ptr<const EventHeaderFilter> eventFilter_;
+    std::unique_ptr<EventSampler> eventSampler_;
+    bool liveSource_ = false;
+    bool stopAtEnd_ = false;
     std::chrono::system_clock::time_point lastTransitionTimestamp_;
     bool initialized_ = false;
     size_t numEventsPerRetrieval_ = 1;
     INT lastRunNumber_ = -1;
     bool clearProductsOnNewRun_ = true;
+    bool stampSourceTime_ = false;
     std::unordered_set<std::string> tagsToOmitFromClear_;
 
     std::shared_ptr<ConfigManager> configManager_;
     std::unique_ptr<Pipeline> pipeline_;
+    JsonWriter eventWriter_;
+
+    uint64_t eventsProcessed_ = 0;
+    uint64_t eventsSinceReport_ = 0;
+    uint64_t eventsFilteredOutSinceReport_ = 0;
+    uint64_t sourceFilteredCount_ = 0;
+    uint64_t eventsSampledOutSinceReport_ = 0;
+    std::chrono::steady_clock::time_point reportStart_;
 
     void handleTransitions();
+    void reportThroughput();
     void setRunNumber(INT newRunNumber);
     INT getRunNumberFromOdb(const std::string& odbPath = "/Runinfo/Run number") const;
 };
@@ -2,7 +2,7 @@
 #define MIDAS_ODB_PROCESSOR_H
 
 #include "processors/GeneralProcessor.h"
-#include "MidasReceiver.h"
+#include "receivers/MidasReceiverInterface.h"
 #include <nlohmann/json.hpp>
 #include <chrono>
 #include <vector>
@@ -19,7 +19,7 @@ public:
 
 private:
     std::chrono::system_clock::time_point lastProcessedTime_ = std::chrono::system_clock::now();
-    MidasReceiver& midasReceiver_;
+    MidasReceiverInterface& midasReceiver_;
     bool initialized_ = false;
 };
 
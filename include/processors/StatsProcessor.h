@@ -0,0 +1,52 @@
+// StatsProcessor.h
+#ifndef STATS_PROCESSOR_H
+#define STATS_PROCESSOR_H
+
+#include "processors/GeneralProcessor.h"
+#include "metrics/MetricsRegistry.h"
+#include "utilities/JsonWriter.h"
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Publishes the publisher's own health, for operators watching the ZMQ feeds.
+ *
+ * The `StatsProcessor` class turns the MetricsRegistry into one JSON message per
+ * period: message and byte rates, drop counts and latency percentiles per channel,
+ * run rates, processing-time percentiles and deadline misses per processor, the main
+ * loop's duration and deadline misses, the MIDAS receiver's buffer fill and the
+ * resident set size. Rates and percentiles cover the time since the previous message;
+ * totals are since start.
+ *
+ * Configure it like any processor, typically in a channel of its own:
+ * @code
+ * "stats-channel": {
+ *   "zmq-address": "tcp://127.0.0.1:5557",
+ *   "name": "STATS",
+ *   "processors": [ { "processor": "StatsProcessor", "period-ms": 1000 } ]
+ * }
+ * @endcode
+ */
+class StatsProcessor : public GeneralProcessor {
+public:
+    explicit StatsProcessor(int verbose = 0);
+
+    std::vector<std::string> getProcessedOutput() override;
+    bool isReadyToProcess() const override;
+
+private:
+    std::chrono::steady_clock::time_point lastProcessedTime_; ///< When the previous message was built.
+    std::map<const Counter*, uint64_t> previousCounts_; ///< Counter values at the previous message.
+    std::map<const Histogram*, HistogramSnapshot> previousHistograms_; ///< Histograms at the previous message.
+    JsonWriter writer_; ///< Writer the message is built in.
+
+    double rate(const Counter* counter, double seconds);
+    void writeLatency(const char* key, const Histogram* histogram);
+    void writeReceiver();
+
+    static size_t getResidentSetBytes();
+};
+
+#endif // STATS_PROCESSOR_H
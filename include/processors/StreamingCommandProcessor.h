@@ -0,0 +1,72 @@
+// StreamingCommandProcessor.h
+#ifndef STREAMING_COMMAND_PROCESSOR_H
+#define STREAMING_COMMAND_PROCESSOR_H
+
+#include "processors/GeneralProcessor.h"
+#include "command_management/Subprocess.h"
+#include "utilities/RecordSplitter.h"
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+/**
+ * @brief A processor that runs one long-lived command and publishes what it writes.
+ *
+ * Unlike `CommandProcessor`, which runs its command again every period, the
+ * `StreamingCommandProcessor` class starts the command once and polls its stdout
+ * without blocking, so producers such as `tail -f` or `journalctl -f` are neither
+ * re-spawned nor lose output between runs. Every record, by default a line, becomes
+ * one buffer entry. Each run reads at most "max-read-bytes"; a command writing
+ * faster than that is left waiting in its pipe until the next run. If the command
+ * exits, it is restarted after a backoff that doubles on each quick failure.
+ *
+ * @code
+ * { "processor": "StreamingCommandProcessor", "period-ms": 100,
+ *   "command": "journalctl -f -o cat", "delimiter": "\n",
+ *   "max-record-bytes": 1048576, "max-read-bytes": 16777216,
+ *   "restart-backoff-ms": 1000, "max-restart-backoff-ms": 30000 }
+ * @endcode
+ */
+class StreamingCommandProcessor : public GeneralProcessor {
+public:
+    explicit StreamingCommandProcessor(int verbose = 0);
+    ~StreamingCommandProcessor() override;
+
+    /**
+     * @brief Reads the command and streaming settings. The command starts on the first run.
+     * @param config The processor configuration.
+     * @throws std::invalid_argument if "command" is missing or empty.
+     */
+    void Init(const nlohmann::json& config);
+
+    std::vector<std::string> getProcessedOutput() override;
+    bool isReadyToProcess() const override;
+
+private:
+    std::unique_ptr<Subprocess> process_; ///< The running command.
+    RecordSplitter records_; ///< Cuts the output into records.
+    size_t maxReadBytes_ = 16777216; ///< Most output bytes read per run; the rest follows next run.
+    std::chrono::milliseconds initialBackoff_{1000}; ///< Wait before the first restart.
+    std::chrono::milliseconds maxBackoff_{30000}; ///< Longest wait between restarts.
+    std::chrono::milliseconds backoff_{1000}; ///< Wait before the next restart.
+    std::chrono::steady_clock::time_point lastProcessedTime_; ///< When the output was last polled.
+    std::chrono::steady_clock::time_point startedAt_; ///< When the command was last started.
+    std::chrono::steady_clock::time_point nextStart_; ///< Earliest time of the next (re)start.
+    bool running_ = false; ///< Whether the command has been started and its output not yet ended.
+    uint64_t restarts_ = 0; ///< Times the command has exited and been scheduled for a restart.
+
+    /**
+     * @brief Starts the command if it is not running and its backoff has passed.
+     */
+    void ensureRunning();
+
+    /**
+     * @brief Handles the command having exited: flushes its output and schedules a restart.
+     * @param out The entries to append the last partial record to.
+     */
+    void handleExit(std::vector<std::string>& out);
+};
+
+#endif // STREAMING_COMMAND_PROCESSOR_H
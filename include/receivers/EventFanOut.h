@@ -0,0 +1,260 @@
+// EventFanOut.h
+#ifndef EVENT_FAN_OUT_H
+#define EVENT_FAN_OUT_H
+
+#include "receivers/MidasReceiverInterface.h"
+#include "metrics/Metrics.h"
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class EventFanOut;
+class EventHeaderFilter;
+
+/**
+ * @brief One consumer's view of the events received by an EventFanOut.
+ *
+ * Each consumer reads the fan-out's event log through its own sequence-number cursor
+ * and may lag at most its capacity behind the newest event. When it falls further
+ * behind, its cursor skips ahead and the skipped events are counted as dropped; other
+ * consumers are not affected. Events are shared with every other consumer and must not
+ * be modified.
+ */
+class EventConsumer {
+public:
+    /**
+     * @brief Takes the oldest unread events, receiving new ones first.
+     * @param maxEvents Maximum number of events to return.
+     * @param filter Events it rejects are passed over and do not count toward maxEvents, or nullptr.
+     * @return The events, oldest first.
+     */
+    TimedEventList take(size_t maxEvents, const EventHeaderFilter* filter = nullptr);
+
+    /**
+     * @brief Gets the consumer's name.
+     * @return The name.
+     */
+    const std::string& getName() const;
+
+    /**
+     * @brief Gets the number of events received but not yet taken.
+     * @return The number of events.
+     */
+    size_t getQueuedCount() const;
+
+    /**
+     * @brief Gets the number of events skipped because the consumer fell too far behind.
+     * @return The number of events.
+     */
+    uint64_t getDroppedCount() const;
+
+    /**
+     * @brief Gets the sequence number of the next event to be taken.
+     * @return The sequence number.
+     */
+    uint64_t getNextSequence() const;
+
+    /**
+     * @brief Receives new events without taking any.
+     * @return The number of events received but not yet taken.
+     */
+    size_t poll();
+
+    /**
+     * @brief Skips the oldest unread events, receiving new ones first.
+     * @param keep Maximum number of unread events left afterwards.
+     * @param notBefore Unread events received before this time are skipped as well.
+     * @param filter With a filter, keep counts only the events it accepts; or nullptr.
+     * @return The number of events skipped.
+     */
+    uint64_t skip(size_t keep,
+                  std::chrono::system_clock::time_point notBefore = std::chrono::system_clock::time_point::min(),
+                  const EventHeaderFilter* filter = nullptr);
+
+    /**
+     * @brief Gets the number of events skipped on request by skip().
+     * @return The number of events.
+     */
+    uint64_t getSkippedCount() const;
+
+    /**
+     * @brief Gets the number of events passed over by take() because its filter rejected them.
+     * @return The number of events.
+     */
+    uint64_t getFilteredCount() const;
+
+    /**
+     * @brief Gets how long the oldest unread event has been waiting.
+     * @return The age of the oldest unread event, zero when caught up.
+     */
+    std::chrono::milliseconds getLag() const;
+
+private:
+    friend class EventFanOut;
+
+    EventConsumer(EventFanOut& fanOut, const std::string& name, size_t capacity, uint64_t nextSequence);
+
+    EventFanOut& fanOut_; ///< The fan-out feeding this consumer.
+    std::string name_; ///< Name used in logs and metrics.
+    size_t capacity_; ///< Maximum number of unread events before the oldest are dropped.
+    uint64_t nextSequence_; ///< Sequence number of the next event to take. Guarded by the fan-out.
+    uint64_t dropped_ = 0; ///< Events skipped for lagging. Guarded by the fan-out.
+    uint64_t skipped_ = 0; ///< Events skipped by skip(). Guarded by the fan-out.
+    uint64_t filtered_ = 0; ///< Events passed over by take() for its filter. Guarded by the fan-out.
+    Gauge* queueDepth_; ///< Exposes the number of unread events.
+    Gauge* lagMs_; ///< Exposes the age of the oldest unread event.
+    Counter* delivered_; ///< Counts events taken.
+    Counter* droppedCounter_; ///< Counts events skipped for lagging.
+    Counter* skippedCounter_; ///< Counts events skipped by skip().
+
+    /**
+     * @brief Skips the cursor past events beyond the consumer's capacity. Called with the fan-out locked.
+     */
+    void enforceCapacity();
+
+    /**
+     * @brief Gets the age of the oldest unread event. Called with the fan-out locked.
+     * @return The age, zero when caught up.
+     */
+    std::chrono::milliseconds getLagLocked() const;
+
+    /**
+     * @brief Updates the queue depth and lag gauges. Called with the fan-out locked.
+     */
+    void updateLag();
+};
+
+/**
+ * @brief Receives each MIDAS event once and hands it to every registered consumer.
+ *
+ * The `EventFanOut` class keeps the only read cursor on the receiver. Whenever a
+ * consumer asks for events, everything new is pulled from the receiver once, given the
+ * next receive sequence number and appended to a shared log, so adding a channel adds
+ * no receive or copy cost. Consumers read the log by sequence number, which makes
+ * duplicates impossible and counts exactly how many events each one missed. It also
+ * starts the receiver exactly once.
+ *
+ * The receiver itself can only be queried by timestamp. Events sharing the timestamp
+ * of the last one received are asked for again and recognized by event ID and serial
+ * number, so none is skipped or received twice. Gaps in each event ID's serial numbers
+ * estimate how many events the receiver lost before they could be pulled; this only
+ * holds while the receiver gets every event, so sampled reception turns it off.
+ * @see MidasReceiverProvider::getFanOut
+ */
+class EventFanOut {
+public:
+    /**
+     * @brief Constructor for EventFanOut.
+     * @param receiver The receiver to pull events from.
+     */
+    explicit EventFanOut(MidasReceiverInterface& receiver);
+
+    /**
+     * @brief Starts the receiver unless it is already running.
+     */
+    void start();
+
+    /**
+     * @brief Registers a consumer. Only events received after this call are read by it.
+     * @param name Name used in logs and metrics.
+     * @param queueCapacity Maximum number of unread events, 0 for the receiver's buffer size.
+     * @return The consumer. Dropping the last reference unregisters it.
+     */
+    std::shared_ptr<EventConsumer> subscribe(const std::string& name, size_t queueCapacity = 0);
+
+    /**
+     * @brief Pulls new events from the receiver and appends them to the log.
+     * @return The number of events received.
+     */
+    size_t poll();
+
+    /**
+     * @brief Gets the sequence number the next received event will get.
+     * @return The sequence number; every event received so far has a smaller one.
+     */
+    uint64_t getNextSequence() const;
+
+    /**
+     * @brief Gets the estimated number of events lost before they reached the fan-out.
+     * @return The sum of the gaps in each event ID's serial numbers.
+     */
+    uint64_t getSerialGapCount() const;
+
+    /**
+     * @brief Turns counting serial-number gaps on or off. It is on by default.
+     * @param enabled False when the receiver samples events, where gaps are expected.
+     */
+    void setSerialGapTracking(bool enabled);
+
+    /**
+     * @brief Checks whether serial-number gaps are counted.
+     * @return True if getSerialGapCount() is meaningful.
+     */
+    bool isTrackingSerialGaps() const;
+
+    /**
+     * @brief Gets how full the most backed-up consumer's queue is.
+     * @return Unread events over capacity for the fullest consumer, or 0 without consumers.
+     */
+    double getFill() const;
+
+    /**
+     * @brief Gets the registered consumers.
+     * @return The consumers still referenced elsewhere.
+     */
+    std::vector<std::shared_ptr<const EventConsumer>> getConsumers() const;
+
+private:
+    friend class EventConsumer;
+
+    MidasReceiverInterface& receiver_; ///< The receiver events are pulled from.
+    mutable std::mutex mutex_; ///< Guards everything below and every consumer's cursor.
+    std::chrono::system_clock::time_point cursor_; ///< Timestamp of the last event received.
+    std::vector<std::pair<uint16_t, uint32_t>> cursorEvents_; ///< Event ID and serial of received events at cursor_.
+    std::deque<TimedEventPtr> log_; ///< Received events not yet read by every consumer.
+    uint64_t firstSequence_ = 0; ///< Sequence number of log_.front().
+    std::map<uint16_t, uint32_t> lastSerials_; ///< Last serial number received per event ID.
+    uint64_t serialGaps_ = 0; ///< Events missing between consecutive serial numbers.
+    bool trackSerialGaps_ = true; ///< Whether serial-number gaps are counted.
+    std::vector<std::weak_ptr<EventConsumer>> consumers_; ///< Registered consumers.
+    bool started_ = false; ///< Whether start() has run.
+    Counter* received_; ///< Counts events pulled from the receiver.
+    Counter* serialGapCounter_; ///< Counts events missing between consecutive serial numbers.
+
+    /**
+     * @brief Pulls new events and appends them to the log. Called with the fan-out locked.
+     * @return The number of events received.
+     */
+    size_t pollLocked();
+
+    /**
+     * @brief Checks if an event at the cursor timestamp was already received. Called with the fan-out locked.
+     * @param event The event.
+     * @return True if it is a repeat, false otherwise.
+     */
+    bool isRepeat(const TimedEventPtr& event) const;
+
+    /**
+     * @brief Counts any serial-number gap before an event. Called with the fan-out locked.
+     * @param event The newly received event.
+     */
+    void trackSerial(const TMEvent& event);
+
+    /**
+     * @brief Drops events from the front of the log that every consumer has read or skipped.
+     */
+    void trimLog();
+
+    /**
+     * @brief Gets the default consumer capacity and pull size.
+     * @return The receiver's buffer capacity, or a fallback if it is unknown.
+     */
+    size_t getBatchSize();
+};
+
+#endif // EVENT_FAN_OUT_H
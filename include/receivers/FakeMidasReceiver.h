@@ -0,0 +1,78 @@
+// FakeMidasReceiver.h
+#ifndef FAKE_MIDAS_RECEIVER_H
+#define FAKE_MIDAS_RECEIVER_H
+
+#include "receivers/MidasReceiverInterface.h"
+#include "event_sources/EventSource.h"
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief In-process stand-in for MidasReceiver, for tests and benchmarks.
+ *
+ * The `FakeMidasReceiver` class serves events, an ODB tree and run transitions
+ * without a MIDAS installation. A background thread pulls events from an offline
+ * event source (synthetic or recorded `.mid` files) into a bounded buffer, the way
+ * the real receiver buffers events from the experiment. Run transitions are
+ * generated at a fixed run length and reflected in "/Runinfo/Run number".
+ *
+ * Configuration (general-settings.midas-receiver):
+ * - "events": an event source config (see EventSource::createOffline), default synthetic at 1 kHz
+ * - "buffer-size": events kept before the oldest are dropped (default 1000)
+ * - "poll-interval-ms": how often the producer thread runs (default 1)
+ * - "first-run-number": run number at start (default 1)
+ * - "run-length-s": seconds between run transitions; 0 never transitions (default 0)
+ * - "odb": initial ODB tree, or "odb-file": path to a JSON ODB dump
+ * - "odb-size-bytes": pads the ODB with filler values up to roughly this size (default 0)
+ */
+class FakeMidasReceiver : public MidasReceiverInterface {
+public:
+    /**
+     * @brief Constructor for FakeMidasReceiver.
+     * @param config The stand-in configuration.
+     */
+    explicit FakeMidasReceiver(const nlohmann::json& config);
+    ~FakeMidasReceiver() override;
+
+    bool isInitialized() override;
+    void init(const MidasReceiverConfig& config) override;
+    void start() override;
+    void stop() override;
+    bool isRunning() override;
+    bool isListeningForEvents() override;
+    TimedEventList getLatestEvents(size_t maxEvents, std::chrono::system_clock::time_point since) override;
+    TransitionList getLatestTransitions(size_t maxTransitions, std::chrono::system_clock::time_point since) override;
+    std::string getOdb(const std::string& path) override;
+    size_t getBufferedEventCount() override;
+    size_t getBufferCapacity() override;
+    std::optional<uint64_t> getDroppedEventCount() override;
+
+private:
+    std::unique_ptr<EventSource> generator_; ///< Where events come from.
+    size_t bufferSize_; ///< Maximum buffered events.
+    std::chrono::milliseconds pollInterval_; ///< Producer thread period.
+    double runLengthSeconds_; ///< Seconds between run transitions.
+
+    std::mutex mutex_; ///< Guards the buffers, ODB and run number.
+    std::deque<TimedEventPtr> events_; ///< Buffered events, oldest first.
+    TransitionList transitions_; ///< Run transitions, oldest first.
+    nlohmann::json odb_; ///< The served ODB tree.
+    INT runNumber_; ///< Current run number.
+    std::chrono::steady_clock::time_point runStart_; ///< Start of the current run.
+
+    std::atomic<bool> initialized_; ///< Set by init().
+    std::atomic<bool> running_; ///< Set while the producer thread runs.
+    std::atomic<uint64_t> dropped_; ///< Events dropped from a full buffer.
+    std::thread producer_; ///< Producer thread.
+
+    void producerLoop();
+    void startNewRun(std::chrono::system_clock::time_point now);
+};
+
+#endif // FAKE_MIDAS_RECEIVER_H
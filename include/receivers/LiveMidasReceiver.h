@@ -0,0 +1,35 @@
+// LiveMidasReceiver.h
+#ifndef LIVE_MIDAS_RECEIVER_H
+#define LIVE_MIDAS_RECEIVER_H
+
+#include "receivers/MidasReceiverInterface.h"
+
+/**
+ * @brief Adapter exposing the MidasReceiver singleton through MidasReceiverInterface.
+ *
+ * MidasReceiver does not report its buffer fill or drops, so the fill is counted by
+ * fetching the whole buffer; call getBufferedEventCount() at monitoring rates only.
+ */
+class LiveMidasReceiver : public MidasReceiverInterface {
+public:
+    LiveMidasReceiver();
+
+    bool isInitialized() override;
+    void init(const MidasReceiverConfig& config) override;
+    void start() override;
+    void stop() override;
+    bool isRunning() override;
+    bool isListeningForEvents() override;
+    TimedEventList getLatestEvents(size_t maxEvents, std::chrono::system_clock::time_point since) override;
+    TransitionList getLatestTransitions(size_t maxTransitions, std::chrono::system_clock::time_point since) override;
+    std::string getOdb(const std::string& path) override;
+    size_t getBufferedEventCount() override;
+    size_t getBufferCapacity() override;
+    std::optional<uint64_t> getDroppedEventCount() override;
+
+private:
+    MidasReceiver& receiver_; ///< The wrapped singleton.
+    size_t bufferCapacity_; ///< Buffer size given to init().
+};
+
+#endif // LIVE_MIDAS_RECEIVER_H
@@ -0,0 +1,112 @@
+// MidasReceiverInterface.h
+#ifndef MIDAS_RECEIVER_INTERFACE_H
+#define MIDAS_RECEIVER_INTERFACE_H
+
+#include "MidasReceiver.h"
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+
+/**
+ * @brief The event and transition list types handed out by MidasReceiver.
+ */
+using TimedEventList = decltype(std::declval<MidasReceiver&>().getLatestEvents(
+    size_t{}, std::chrono::system_clock::time_point{}));
+using TimedEventPtr = typename TimedEventList::value_type;
+using TimedEventType = typename TimedEventPtr::element_type;
+
+using TransitionList = decltype(std::declval<MidasReceiver&>().getLatestTransitions(
+    size_t{}, std::chrono::system_clock::time_point{}));
+using TransitionType = typename TransitionList::value_type;
+
+/**
+ * @brief The operations the publisher needs from a MIDAS receiver.
+ *
+ * The `MidasReceiverInterface` class lets processors and main work against either
+ * the real MidasReceiver singleton or an in-process stand-in, so the publisher can
+ * be exercised without a MIDAS installation.
+ * @see MidasReceiverProvider
+ */
+class MidasReceiverInterface {
+public:
+    virtual ~MidasReceiverInterface() = default;
+
+    /**
+     * @brief Checks if init() has been called.
+     * @return True if initialized, false otherwise.
+     */
+    virtual bool isInitialized() = 0;
+
+    /**
+     * @brief Connects to the experiment.
+     * @param config Connection and buffering settings.
+     */
+    virtual void init(const MidasReceiverConfig& config) = 0;
+
+    /**
+     * @brief Starts receiving events. Safe to call more than once.
+     */
+    virtual void start() = 0;
+
+    /**
+     * @brief Stops receiving events.
+     */
+    virtual void stop() = 0;
+
+    /**
+     * @brief Checks if the receiver has been started.
+     * @return True if running, false otherwise.
+     */
+    virtual bool isRunning() = 0;
+
+    /**
+     * @brief Checks if the receiver is still listening for events.
+     * @return True if listening, false otherwise.
+     */
+    virtual bool isListeningForEvents() = 0;
+
+    /**
+     * @brief Gets buffered events received after a given time, oldest first.
+     * @param maxEvents Maximum number of events to return.
+     * @param since Only events with a later timestamp are returned.
+     * @return The events.
+     */
+    virtual TimedEventList getLatestEvents(size_t maxEvents, std::chrono::system_clock::time_point since) = 0;
+
+    /**
+     * @brief Gets run transitions received after a given time, oldest first.
+     * @param maxTransitions Maximum number of transitions to return.
+     * @param since Only transitions with a later timestamp are returned.
+     * @return The transitions.
+     */
+    virtual TransitionList getLatestTransitions(size_t maxTransitions, std::chrono::system_clock::time_point since) = 0;
+
+    /**
+     * @brief Gets an ODB subtree as JSON.
+     * @param path ODB path, e.g. "/" or "/Runinfo/Run number".
+     * @return The JSON text.
+     */
+    virtual std::string getOdb(const std::string& path) = 0;
+
+    /**
+     * @brief Gets the number of events currently buffered.
+     * @return The number of buffered events.
+     */
+    virtual size_t getBufferedEventCount() = 0;
+
+    /**
+     * @brief Gets the maximum number of events buffered before the oldest are dropped.
+     * @return The buffer capacity, or 0 if unknown.
+     */
+    virtual size_t getBufferCapacity() = 0;
+
+    /**
+     * @brief Gets the number of events dropped from a full buffer.
+     * @return The number of dropped events, or nothing if the receiver does not count them.
+     */
+    virtual std::optional<uint64_t> getDroppedEventCount() = 0;
+};
+
+#endif // MIDAS_RECEIVER_INTERFACE_H
@@ -0,0 +1,56 @@
+// MidasReceiverProvider.h
+#ifndef MIDAS_RECEIVER_PROVIDER_H
+#define MIDAS_RECEIVER_PROVIDER_H
+
+#include "receivers/MidasReceiverInterface.h"
+#include "receivers/EventFanOut.h"
+#include <nlohmann/json.hpp>
+#include <memory>
+
+/**
+ * @brief Singleton deciding which MIDAS receiver the publisher talks to.
+ *
+ * The `MidasReceiverProvider` class hands out either the real MidasReceiver or a
+ * FakeMidasReceiver, chosen by general-settings.midas-receiver.type ("live" or
+ * "fake"). It must be configured before any processor is created.
+ */
+class MidasReceiverProvider {
+public:
+    /**
+     * @brief Gets the singleton instance of MidasReceiverProvider.
+     * @return Reference to the singleton instance.
+     */
+    static MidasReceiverProvider& Instance();
+
+    /**
+     * @brief Selects the receiver implementation.
+     * @param config The "midas-receiver" configuration object; an empty object selects the live receiver.
+     */
+    void configure(const nlohmann::json& config);
+
+    /**
+     * @brief Gets the selected receiver, defaulting to the live one.
+     * @return Reference to the receiver.
+     */
+    MidasReceiverInterface& get();
+
+    /**
+     * @brief Gets the fan-out that event consumers should read the selected receiver through.
+     * @return Reference to the fan-out.
+     */
+    EventFanOut& getFanOut();
+
+    /**
+     * @brief Checks whether any consumer has asked for the fan-out yet.
+     * @return True if the fan-out exists.
+     */
+    bool hasFanOut() const;
+
+private:
+    MidasReceiverProvider() = default;
+
+    std::unique_ptr<MidasReceiverInterface> receiver_; ///< The selected receiver.
+    std::unique_ptr<EventFanOut> fanOut_; ///< Single reader of the selected receiver, created on first use.
+};
+
+#endif // MIDAS_RECEIVER_PROVIDER_H
@@ -0,0 +1,20 @@
+// Hash.h
+#ifndef HASH_H
+#define HASH_H
+
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief Computes the 64-bit xxHash (XXH64) of a byte string.
+ *
+ * A fast non-cryptographic hash, used to tell payloads apart in logs and to detect
+ * unchanged output. Matches the reference XXH64 on little-endian hosts.
+ *
+ * @param data The bytes to hash.
+ * @param seed The seed (default is 0).
+ * @return The hash.
+ */
+uint64_t xxHash64(std::string_view data, uint64_t seed = 0);
+
+#endif // HASH_H
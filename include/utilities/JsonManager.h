@@ -35,6 +35,13 @@ public:
      */
     const nlohmann::json& getConfig() const;
 
+    /**
+     * @brief Replaces environment variables in the JSON configuration.
+     * @param jsonConfig The JSON configuration.
+     * @return Modified JSON configuration with replaced environment variables.
+     */
+    static nlohmann::json replaceEnvironmentVariables(const nlohmann::json& jsonConfig);
+
 private:
     /**
      * @brief Default constructor for JsonManager.
@@ -52,13 +59,6 @@ private:
      */
     static nlohmann::json config;
 
-    /**
-     * @brief Replaces environment variables in the JSON configuration.
-     * @param jsonConfig The JSON configuration.
-     * @return Modified JSON configuration with replaced environment variables.
-     */
-    static nlohmann::json replaceEnvironmentVariables(const nlohmann::json& jsonConfig);
-
     /**
      * @brief Replaces placeholders in a string with actual values. A helper function for replaceEnvironmentVariables.
      * @param input The input string with placeholders.
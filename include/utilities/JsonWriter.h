@@ -0,0 +1,130 @@
+// JsonWriter.h
+#ifndef JSONWRITER_H
+#define JSONWRITER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <type_traits>
+#include <nlohmann/json.hpp>
+
+/**
+ * @brief A streaming JSON writer that appends directly into one growable buffer.
+ *
+ * The `JsonWriter` class emits compact JSON without building a DOM first. Commas and
+ * colons are inserted automatically; callers only describe the structure. The buffer
+ * can be handed off with release(), in which case the next write reserves the size of
+ * the previous document so it is filled without regrowing.
+ */
+class JsonWriter {
+public:
+    /**
+     * @brief Constructor for JsonWriter.
+     * @param reserveBytes Initial buffer capacity in bytes (default is 0).
+     */
+    explicit JsonWriter(size_t reserveBytes = 0);
+
+    /**
+     * @brief Empties the buffer, keeping its capacity.
+     */
+    void clear();
+
+    JsonWriter& beginObject();
+    JsonWriter& endObject();
+    JsonWriter& beginArray();
+    JsonWriter& endArray();
+
+    /**
+     * @brief Writes an object key. The next value call writes its value.
+     * @param name The key name (escaped as needed).
+     */
+    JsonWriter& key(std::string_view name);
+
+    /**
+     * @brief Writes a string value, escaping it as it is copied into the buffer.
+     * Bytes that are not valid UTF-8 are replaced with U+FFFD, as nlohmann::json does
+     * with error_handler_t::replace.
+     * @param str The string to write.
+     */
+    JsonWriter& value(std::string_view str);
+
+    /**
+     * @brief Writes a C string value.
+     * @param str The null-terminated string to write.
+     */
+    JsonWriter& value(const char* str);
+
+    /**
+     * @brief Writes a boolean value.
+     * @param b The value to write.
+     */
+    JsonWriter& value(bool b);
+
+    /**
+     * @brief Writes a floating point value. Non-finite values are written as null.
+     * @param d The value to write.
+     */
+    JsonWriter& value(double d);
+
+    /**
+     * @brief Writes an integral value.
+     * @tparam T Any integral type other than bool.
+     * @param n The value to write.
+     */
+    template <typename T,
+              typename std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>, int> = 0>
+    JsonWriter& value(T n) {
+        beforeValue();
+        appendInteger(static_cast<std::conditional_t<std::is_signed_v<T>, long long, unsigned long long>>(n));
+        return *this;
+    }
+
+    /**
+     * @brief Writes a null value.
+     */
+    JsonWriter& nullValue();
+
+    /**
+     * @brief Writes already serialized JSON verbatim.
+     * @param json A complete, valid JSON value.
+     */
+    JsonWriter& rawValue(std::string_view json);
+
+    /**
+     * @brief Serializes a nlohmann::json tree straight into the buffer.
+     * @param json The tree to write.
+     */
+    JsonWriter& jsonValue(const nlohmann::json& json);
+
+    /**
+     * @brief Gets the written document.
+     * @return Const reference to the buffer.
+     */
+    const std::string& str() const;
+
+    /**
+     * @brief Gets the number of bytes written.
+     * @return The buffer size.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Moves the buffer out of the writer.
+     * @return The written document.
+     */
+    std::string release();
+
+private:
+    std::string buffer_; ///< Output buffer.
+    std::vector<bool> hasElements_; ///< Per open container, whether a separator is needed.
+    bool afterKey_; ///< True when the next value belongs to a key just written.
+    size_t lastReleasedSize_; ///< Size of the last released document, reserved on the next write.
+
+    void beforeValue();
+    void appendEscaped(std::string_view str);
+    void appendInteger(long long n);
+    void appendInteger(unsigned long long n);
+};
+
+#endif // JSONWRITER_H
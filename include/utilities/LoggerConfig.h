@@ -1,6 +1,7 @@
 #pragma once
 
 #include <spdlog/spdlog.h>
+#include <spdlog/async_logger.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <nlohmann/json.hpp>
@@ -15,8 +16,12 @@ public:
     static void ConfigureFromFile(const std::string& filename);
     static void ConfigureFromFile();  // no-arg overload
 
+    // Flushes and stops the background logging thread, if any; call before exiting
+    static void Shutdown();
+
 private:
     static spdlog::level::level_enum parseLevel(const std::string& levelStr);
+    static spdlog::async_overflow_policy parseOverflowPolicy(const std::string& policyStr);
 };
 
 } // namespace utils
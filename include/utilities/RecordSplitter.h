@@ -0,0 +1,61 @@
+// RecordSplitter.h
+#ifndef RECORD_SPLITTER_H
+#define RECORD_SPLITTER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Cuts a byte stream that arrives in arbitrary chunks into delimited records.
+ *
+ * Data is appended to buffer() as it is read. split() moves every complete record out,
+ * without its delimiter, and keeps the unterminated rest for the next chunk. A record
+ * longer than the maximum is handed out in pieces instead of being buffered without bound.
+ */
+class RecordSplitter {
+public:
+    /**
+     * @brief Constructor for RecordSplitter.
+     * @param delimiter Separates records. Must not be empty.
+     * @param maxRecordBytes Longer records are handed out in pieces of this size.
+     */
+    explicit RecordSplitter(std::string delimiter = "\n", size_t maxRecordBytes = 1048576);
+
+    /**
+     * @brief Gets the buffer new data is appended to.
+     * @return The data not yet split into records.
+     */
+    std::string& buffer();
+
+    /**
+     * @brief Moves every complete record out of the buffer.
+     * @param out The records to append to.
+     */
+    void split(std::vector<std::string>& out);
+
+    /**
+     * @brief Hands out the unterminated rest of the buffer as a last record, if there is any.
+     * @param out The records to append to.
+     */
+    void flush(std::vector<std::string>& out);
+
+    /**
+     * @brief Gets the delimiter.
+     * @return The delimiter.
+     */
+    const std::string& getDelimiter() const;
+
+    /**
+     * @brief Gets the maximum record size.
+     * @return The size in bytes.
+     */
+    size_t getMaxRecordBytes() const;
+
+private:
+    std::string delimiter_; ///< Separates records.
+    size_t maxRecordBytes_; ///< Longer records are handed out in pieces of this size.
+    std::string pending_; ///< Data not yet terminated by a delimiter.
+};
+
+#endif // RECORD_SPLITTER_H
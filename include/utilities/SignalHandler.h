@@ -29,6 +29,17 @@ public:
      */
     bool isQuitSignalReceived() const;
 
+    /**
+     * @brief Requests a clean shutdown, as if a quit signal had been received.
+     */
+    void requestQuit();
+
+    /**
+     * @brief Checks and clears a pending dump request (SIGUSR1).
+     * @return True if SIGUSR1 was received since the last call, false otherwise.
+     */
+    bool consumeDumpRequest();
+
     /**
      * @brief Static function to get the singleton instance of SignalHandler.
      * @return Reference to the singleton instance.
@@ -37,6 +48,7 @@ public:
 
 private:
     std::atomic<bool> quitSignalReceived;  ///< Atomic flag indicating whether a quit signal is received.
+    std::atomic<bool> dumpRequested;  ///< Atomic flag indicating whether SIGUSR1 asked for a diagnostics dump.
 
     /**
      * @brief Registers signal handlers during construction.
@@ -48,6 +60,12 @@ private:
      * @param signal The signal number.
      */
     static void handleQuitSignal(int signal);
+
+    /**
+     * @brief Static function to handle dump requests (SIGUSR1).
+     * @param signal The signal number.
+     */
+    static void handleDumpSignal(int signal);
 };
 
 #endif // SIGNALHANDLER_H
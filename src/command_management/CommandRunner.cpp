@@ -1,16 +1,33 @@
 #include "command_management/CommandRunner.h"
-#include <stdexcept>
-#include <array>
-#include <memory>
-#include <cstdio>
+#include "command_management/Subprocess.h"
+#include <spdlog/spdlog.h>
+#include <cstring>
 #include <sstream>
 #include <chrono>
+#include <limits>
+#include <sys/wait.h>
+
+const size_t DEFAULT_OUTPUT_LIMIT_BYTES = 16 * 1024 * 1024;
+const size_t STDERR_LIMIT_BYTES = 64 * 1024;
 
 CommandRunner::CommandRunner(const std::string& command)
-    : commandWithArgs_{command}, waitTime_{0} {}
+    : useShell_(needsShell(command)), waitTime_{0}, outputLimit_(DEFAULT_OUTPUT_LIMIT_BYTES),
+      lastExitStatus_(-1), outputTruncated_(false) {
+    if (useShell_) {
+        commandWithArgs_.push_back(command);
+        return;
+    }
+    // Without shell syntax, the shell would only have split the command on whitespace
+    std::istringstream words(command);
+    std::string word;
+    while (words >> word) {
+        commandWithArgs_.push_back(word);
+    }
+}
 
 CommandRunner::CommandRunner(const std::vector<std::string>& commandWithArgs)
-    : commandWithArgs_(commandWithArgs), waitTime_{0} {}
+    : commandWithArgs_(commandWithArgs), useShell_(false), waitTime_{0}, outputLimit_(DEFAULT_OUTPUT_LIMIT_BYTES),
+      lastExitStatus_(-1), outputTruncated_(false) {}
 
 void CommandRunner::addArgument(const std::string& arg) {
     commandWithArgs_.push_back(arg);
@@ -20,32 +37,70 @@ void CommandRunner::setWaitTime(int milliseconds) {
     waitTime_ = milliseconds;
 }
 
-std::string CommandRunner::execute() {
-    std::string output;
-    std::array<char, 128> buffer;
+void CommandRunner::setOutputLimit(size_t bytes) {
+    outputLimit_ = bytes;
+}
 
-    // Build the command string from the vector of strings
-    std::string command;
-    for (const std::string& arg : commandWithArgs_) {
-        command += arg;
-        command += ' ';
+const std::string& CommandRunner::execute() {
+    output_.clear();
+    stderr_.clear();
+    outputTruncated_ = false;
+    if (commandWithArgs_.empty()) {
+        return output_;
     }
 
-    // Open a pipe to the command
-    std::shared_ptr<FILE> pipe(popen(command.c_str(), "r"), pclose);
-    if (!pipe) {
-        throw std::runtime_error("Failed to run the command.");
+    // A shell command keeps stderr on the terminal, as it did when it was run with popen
+    Subprocess process = useShell_ ? Subprocess(getCommand()) : Subprocess(commandWithArgs_, true);
+    int previousStatus = lastExitStatus_;
+    if (!process.start()) {
+        // Fail like the shell would for a missing program, so a bad command does not stop the publisher
+        lastExitStatus_ = 127;
+        int error = process.getStartError();
+        stderr_ = error != 0 ? std::strerror(error) : "could not be started";
+        if (lastExitStatus_ != previousStatus) {
+            spdlog::warn("[CommandRunner] Failed to run '{}': {}", getCommand(), stderr_);
+        }
+        lastExecutionTime = std::chrono::high_resolution_clock::now();
+        return output_;
     }
 
-    // Read the command's output into the string
-    while (!feof(pipe.get())) {
-        if (fgets(buffer.data(), buffer.size(), pipe.get()) != nullptr) {
-            output += buffer.data();
+    while (!process.isAtEnd()) {
+        process.waitForOutput(-1);
+        process.readAvailableStderr(stderr_, STDERR_LIMIT_BYTES - stderr_.size());
+        if (outputLimit_ == 0) {
+            process.readAvailable(output_);
+            continue;
         }
+
+        // Read one byte past the limit, so output of exactly the limit followed by EOF is kept whole
+        size_t room = outputLimit_ - output_.size();
+        process.readAvailable(output_, room < std::numeric_limits<size_t>::max() ? room + 1 : room);
+        if (output_.size() > outputLimit_) {
+            output_.resize(outputLimit_);
+            outputTruncated_ = true;
+            spdlog::warn("[CommandRunner] '{}' wrote more than {} bytes, stopping it", getCommand(), outputLimit_);
+            process.stop();
+            break;
+        }
+    }
+
+    int status = process.wait();
+    if (status < 0) {
+        lastExitStatus_ = -1;
+    } else if (WIFSIGNALED(status)) {
+        lastExitStatus_ = 128 + WTERMSIG(status);
+    } else {
+        lastExitStatus_ = WEXITSTATUS(status);
+    }
+
+    // Only report changes, so a command failing every period does not flood the log
+    if (lastExitStatus_ != 0 && lastExitStatus_ != previousStatus && !outputTruncated_) {
+        spdlog::warn("[CommandRunner] '{}' exited with status {}: {}", getCommand(), lastExitStatus_,
+                     stderr_.substr(0, stderr_.find('\n')));
     }
 
     lastExecutionTime = std::chrono::high_resolution_clock::now();
-    return output;
+    return output_;
 }
 
 bool CommandRunner::isReadyForExecution() const {
@@ -57,8 +112,10 @@ std::string CommandRunner::getCommand() const {
     // Build the command string from the vector of strings
     std::string command;
     for (const std::string& arg : commandWithArgs_) {
+        if (!command.empty()) {
+            command += ' ';
+        }
         command += arg;
-        command += ' ';
     }
     return command;
 }
@@ -66,3 +123,23 @@ std::string CommandRunner::getCommand() const {
 int CommandRunner::getWaitTime() const {
     return waitTime_;
 }
+
+size_t CommandRunner::getOutputLimit() const {
+    return outputLimit_;
+}
+
+const std::string& CommandRunner::getLastStderr() const {
+    return stderr_;
+}
+
+int CommandRunner::getLastExitStatus() const {
+    return lastExitStatus_;
+}
+
+bool CommandRunner::wasOutputTruncated() const {
+    return outputTruncated_;
+}
+
+bool CommandRunner::needsShell(const std::string& command) {
+    return command.find_first_of("|&;<>()$`\\\"'*?[]#~={}%!\n") != std::string::npos;
+}
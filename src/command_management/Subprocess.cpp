@@ -0,0 +1,249 @@
+#include "command_management/Subprocess.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <chrono>
+#include <thread>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+const std::chrono::milliseconds STOP_GRACE_PERIOD(500);
+// A full pipe buffer per read, so a chatty command needs few read calls
+const size_t READ_CHUNK_BYTES = 65536;
+
+Subprocess::Subprocess(const std::string& command)
+    : command_(command), captureStderr_(false), pid_(-1), stdoutFd_(-1), stderrFd_(-1), atEnd_(false),
+      exitStatus_(-1), startError_(0) {}
+
+Subprocess::Subprocess(const std::vector<std::string>& argv, bool captureStderr)
+    : argv_(argv), captureStderr_(captureStderr), pid_(-1), stdoutFd_(-1), stderrFd_(-1), atEnd_(false),
+      exitStatus_(-1), startError_(0) {
+    for (const std::string& arg : argv_) {
+        command_ += command_.empty() ? arg : " " + arg;
+    }
+}
+
+Subprocess::~Subprocess() {
+    stop();
+}
+
+bool Subprocess::start() {
+    stop();
+    startError_ = 0;
+    if (argv_.empty() && command_.empty()) {
+        spdlog::error("[Subprocess] Nothing to run");
+        return false;
+    }
+
+    int outPipe[2];
+    int errPipe[2] = {-1, -1};
+    if (pipe2(outPipe, O_CLOEXEC) != 0 || (captureStderr_ && pipe2(errPipe, O_CLOEXEC) != 0)) {
+        spdlog::error("[Subprocess] Failed to create a pipe for '{}': {}", command_, std::strerror(errno));
+        return false;
+    }
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, outPipe[1], STDOUT_FILENO);
+    if (captureStderr_) {
+        posix_spawn_file_actions_adddup2(&actions, errPipe[1], STDERR_FILENO);
+    }
+
+    // A process group of its own, so stop() reaches every process of a pipeline
+    posix_spawnattr_t attributes;
+    posix_spawnattr_init(&attributes);
+    posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETPGROUP);
+    posix_spawnattr_setpgroup(&attributes, 0);
+
+    int result;
+    if (argv_.empty()) {
+        const char* argv[] = {"/bin/sh", "-c", command_.c_str(), nullptr};
+        result = posix_spawn(&pid_, "/bin/sh", &actions, &attributes, const_cast<char* const*>(argv), environ);
+    } else {
+        std::vector<char*> argv;
+        argv.reserve(argv_.size() + 1);
+        for (std::string& arg : argv_) {
+            argv.push_back(arg.data());
+        }
+        argv.push_back(nullptr);
+        result = posix_spawnp(&pid_, argv[0], &actions, &attributes, argv.data(), environ);
+    }
+    posix_spawn_file_actions_destroy(&actions);
+    posix_spawnattr_destroy(&attributes);
+    close(outPipe[1]);
+    if (captureStderr_) {
+        close(errPipe[1]);
+    }
+
+    if (result != 0) {
+        // Callers retry every period, so they decide how loudly to report it
+        spdlog::debug("[Subprocess] Failed to start '{}': {}", command_, std::strerror(result));
+        startError_ = result;
+        close(outPipe[0]);
+        if (captureStderr_) {
+            close(errPipe[0]);
+        }
+        pid_ = -1;
+        return false;
+    }
+
+    stdoutFd_ = outPipe[0];
+    stderrFd_ = errPipe[0];
+    for (int fd : {stdoutFd_, stderrFd_}) {
+        if (fd >= 0) {
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        }
+    }
+    atEnd_ = false;
+    exitStatus_ = -1;
+    return true;
+}
+
+size_t Subprocess::readAvailable(std::string& output, size_t maxBytes) {
+    size_t bytes = readPipe(stdoutFd_, output, maxBytes, false);
+    if (stdoutFd_ < 0) {
+        atEnd_ = true;
+    }
+    return bytes;
+}
+
+size_t Subprocess::readAvailableStderr(std::string& output, size_t maxBytes) {
+    return readPipe(stderrFd_, output, maxBytes, true);
+}
+
+size_t Subprocess::readPipe(int& fd, std::string& output, size_t maxBytes, bool discardExcess) {
+    size_t total = 0;
+    std::array<char, 4096> discard;
+    while (fd >= 0) {
+        size_t room = maxBytes - total;
+        if (room == 0 && !discardExcess) {
+            break;
+        }
+
+        // Read straight into the caller's string, which keeps its capacity between runs
+        ssize_t bytes;
+        if (room > 0) {
+            size_t offset = output.size();
+            size_t chunk = std::min(room, READ_CHUNK_BYTES);
+            output.resize(offset + chunk);
+            bytes = read(fd, &output[offset], chunk);
+            output.resize(offset + static_cast<size_t>(std::max<ssize_t>(bytes, 0)));
+        } else {
+            bytes = read(fd, discard.data(), discard.size());
+        }
+
+        if (bytes > 0) {
+            total += room > 0 ? static_cast<size_t>(bytes) : 0;
+        } else if (bytes == 0) {
+            close(fd);
+            fd = -1;
+        } else if (errno == EINTR) {
+            continue;
+        } else {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                spdlog::warn("[Subprocess] Failed to read from '{}': {}", command_, std::strerror(errno));
+                close(fd);
+                fd = -1;
+            }
+            break;
+        }
+    }
+    return total;
+}
+
+bool Subprocess::waitForOutput(int timeoutMs) {
+    std::array<pollfd, 2> fds;
+    nfds_t count = 0;
+    for (int fd : {stdoutFd_, stderrFd_}) {
+        if (fd >= 0) {
+            fds[count++] = {fd, POLLIN, 0};
+        }
+    }
+    if (count == 0) {
+        return false;
+    }
+
+    int ready;
+    do {
+        ready = poll(fds.data(), count, timeoutMs);
+    } while (ready < 0 && errno == EINTR);
+    return ready > 0;
+}
+
+bool Subprocess::isRunning() {
+    if (pid_ <= 0) {
+        return false;
+    }
+    int status = 0;
+    pid_t result = waitpid(pid_, &status, WNOHANG);
+    if (result == pid_ || (result < 0 && errno == ECHILD)) {
+        exitStatus_ = result == pid_ ? status : -1;
+        pid_ = -1;
+        return false;
+    }
+    return true;
+}
+
+bool Subprocess::isAtEnd() const {
+    return atEnd_ && stderrFd_ < 0;
+}
+
+int Subprocess::wait() {
+    if (pid_ > 0) {
+        int status = 0;
+        pid_t result;
+        do {
+            result = waitpid(pid_, &status, 0);
+        } while (result < 0 && errno == EINTR);
+        exitStatus_ = result == pid_ ? status : -1;
+        pid_ = -1;
+    }
+    return exitStatus_;
+}
+
+void Subprocess::stop() {
+    closePipes();
+    if (!isRunning()) {
+        return;
+    }
+
+    kill(-pid_, SIGTERM);
+    auto deadline = std::chrono::steady_clock::now() + STOP_GRACE_PERIOD;
+    while (isRunning() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    if (isRunning()) {
+        spdlog::warn("[Subprocess] '{}' ignored SIGTERM, killing it", command_);
+        kill(-pid_, SIGKILL);
+        wait();
+    }
+}
+
+int Subprocess::getExitStatus() const {
+    return exitStatus_;
+}
+
+int Subprocess::getStartError() const {
+    return startError_;
+}
+
+const std::string& Subprocess::getCommand() const {
+    return command_;
+}
+
+void Subprocess::closePipes() {
+    for (int* fd : {&stdoutFd_, &stderrFd_}) {
+        if (*fd >= 0) {
+            close(*fd);
+            *fd = -1;
+        }
+    }
+}
@@ -2,23 +2,32 @@
 #include "data_transmitter/DataTransmitterManager.h"
 #include "data_transmitter/DataTransmitter.h"
 //#include <spdlog/spdlog.h>
+#include "metrics/EventTracer.h"
+#include <algorithm>
+#include <chrono>
 
 const int DEFAULT_CHANNEL_TICK_TIME = 1000;
 
 // Constructors
 DataChannel::DataChannel()
     : name(""), eventsBeforeBreak(1), eventsToIgnoreInBreak(0), address(""),
-      eventsPublished(0), eventsSeen(0), onBreak(false), eventsSeenOnBreak(0) {
+      eventsPublished(0), eventsSeen(0), onBreak(false), eventsSeenOnBreak(0),
+      metrics(&MetricsRegistry::Instance().channel("")), priority(0), latencyBudgetMs(0),
+      bufferByteBudget(0), bufferEvictionsReported(0) {
 }
 
 DataChannel::DataChannel(const std::string& name, int eventsBeforeBreak, int eventsToIgnoreInBreak)
     : name(name), eventsBeforeBreak(eventsBeforeBreak), eventsToIgnoreInBreak(eventsToIgnoreInBreak), address(""),
-      eventsPublished(0), eventsSeen(0), onBreak(false), eventsSeenOnBreak(0) {
+      eventsPublished(0), eventsSeen(0), onBreak(false), eventsSeenOnBreak(0),
+      metrics(&MetricsRegistry::Instance().channel(name)), priority(0), latencyBudgetMs(0),
+      bufferByteBudget(0), bufferEvictionsReported(0) {
 }
 
 DataChannel::DataChannel(const std::string& name, int eventsBeforeBreak, int eventsToIgnoreInBreak, const std::string& address)
     : name(name), eventsBeforeBreak(eventsBeforeBreak), eventsToIgnoreInBreak(eventsToIgnoreInBreak), address(address),
-      eventsPublished(0), eventsSeen(0), onBreak(false), eventsSeenOnBreak(0) {
+      eventsPublished(0), eventsSeen(0), onBreak(false), eventsSeenOnBreak(0),
+      metrics(&MetricsRegistry::Instance().channel(name)), priority(0), latencyBudgetMs(0),
+      bufferByteBudget(0), bufferEvictionsReported(0) {
     initializeTransmitter();
 }
 
@@ -28,10 +37,44 @@ bool DataChannel::publish() {
             return false;
         }
     }
-    if (processesManager.runProcesses()) {
-        std::string serializedData = processesManager.getDataBuffer().SerializeBuffer();
-        return transmitter->publish(*this, serializedData);
+    // Check the rate before running the processors, so a skipped publish costs no processing
+    // and the processors produce their output once it can be sent
+    if (isRateControlled() && processesManager.hasReadyProcessor() && !admitRate()) {
+        EventTracer::Instance().closeOpenTraces();
+        return true;
     }
+
+    bool added = processesManager.runProcesses();
+    updateBufferMetrics();
+    if (added) {
+        const DataBuffer<std::string>& buffer = processesManager.getDataBuffer();
+        size_t entriesAdded = processesManager.getEntriesAddedLastRun();
+        if (entriesAdded > buffer.Capacity()) {
+            metrics->entriesOverwritten->add(entriesAdded - buffer.Capacity());
+        }
+        metrics->bufferDepth->set(static_cast<int64_t>(buffer.Size()));
+
+        auto start = std::chrono::steady_clock::now();
+        serializationWriter.clear();
+        buffer.SerializeBuffer(serializationWriter);
+        metrics->serializationTime->record(elapsedNanoseconds(start));
+
+        EventTracer& tracer = EventTracer::Instance();
+        if (tracer.hasOpenTraces()) {
+            tracer.recordOpen("buffer_serialize", EventTracer::toNanoseconds(start), EventTracer::now());
+        }
+
+        std::string payload = serializationWriter.release();
+        if (isRateControlled()) {
+            messageBucket.consume(1);
+            byteBucket.consume(static_cast<double>(payload.size()));
+        }
+
+        bool success = transmitter->publish(*this, std::move(payload));
+        tracer.closeOpenTraces();
+        return success;
+    }
+    EventTracer::Instance().closeOpenTraces();
     return true;
 }
 
@@ -42,6 +85,7 @@ void DataChannel::updateTickTime() {
 
 void DataChannel::setName(const std::string& name) {
     this->name = name;
+    metrics = &MetricsRegistry::Instance().channel(name);
 }
 
 void DataChannel::setEventsBeforeBreak(int eventsBeforeBreak) {
@@ -57,12 +101,107 @@ void DataChannel::setAddress(const std::string& address) {
     initializeTransmitter();
 }
 
+void DataChannel::setRateLimit(double messagesPerSecond, double messageBurst, double bytesPerSecond, double byteBurst) {
+    messageBucket = TokenBucket(messagesPerSecond, messageBurst);
+    byteBucket = TokenBucket(bytesPerSecond, byteBurst);
+}
+
+bool DataChannel::isRateControlled() const {
+    return messageBucket.isLimited() || byteBucket.isLimited();
+}
+
+bool DataChannel::admitRate() {
+    if (!isRateControlled()) {
+        return true;
+    }
+    // Bytes are only known after serialization, so only require the byte bucket to be out of debt
+    auto now = TokenBucket::Clock::now();
+    if (messageBucket.hasTokens(1, now) && byteBucket.hasTokens(0, now)) {
+        return true;
+    }
+    metrics->messagesRateLimited->add();
+    return false;
+}
+
+void DataChannel::setBufferByteBudget(size_t bytes) {
+    bufferByteBudget = bytes;
+    processesManager.setBufferByteBudget(bytes);
+    updateBufferMetrics();
+}
+
+size_t DataChannel::getBufferByteBudget() const {
+    return bufferByteBudget;
+}
+
+void DataChannel::limitBufferBytes(size_t allowance) {
+    size_t budget = bufferByteBudget;
+    if (allowance > 0) {
+        budget = budget > 0 ? std::min(budget, allowance) : allowance;
+    }
+    processesManager.setBufferByteBudget(budget);
+    updateBufferMetrics();
+}
+
+size_t DataChannel::getBufferResidentBytes() const {
+    return processesManager.getDataBuffer().ResidentBytes();
+}
+
+void DataChannel::updateBufferMetrics() {
+    const DataBuffer<std::string>& buffer = processesManager.getDataBuffer();
+    metrics->bufferBytes->set(static_cast<int64_t>(buffer.ResidentBytes()));
+    metrics->bufferPeakBytes->set(static_cast<int64_t>(buffer.PeakResidentBytes()));
+    uint64_t evicted = buffer.EvictedForBudget();
+    if (evicted > bufferEvictionsReported) {
+        metrics->entriesEvicted->add(evicted - bufferEvictionsReported);
+        bufferEvictionsReported = evicted;
+    }
+}
+
+bool DataChannel::enableSnapshotOnConnect() {
+    return transmitter->enableLastValueCache();
+}
+
 void DataChannel::setDataChannelProcessesManager(DataChannelProcessesManager manager) {
     processesManager = manager;
 }
 
-void DataChannel::addProcessToManager(GeneralProcessor* processor) {
-    processesManager.addProcessor(processor);
+void DataChannel::addProcessToManager(GeneralProcessor* processor, const std::string& processorType, int priority,
+                                      int latencyBudgetMs, int maxSilenceMs) {
+    size_t index = processesManager.getProcessorCount();
+    processesManager.addProcessor(processor, &MetricsRegistry::Instance().processor(name, processorType, index),
+                                  priority, latencyBudgetMs, maxSilenceMs);
+}
+
+void DataChannel::setPriority(int priority) {
+    this->priority = priority;
+}
+
+int DataChannel::getPriority() const {
+    return priority;
+}
+
+void DataChannel::setLatencyBudget(int latencyBudgetMs) {
+    this->latencyBudgetMs = latencyBudgetMs;
+}
+
+int DataChannel::getLatencyBudget() const {
+    return latencyBudgetMs;
+}
+
+void DataChannel::setSheddingThreshold(int threshold) {
+    processesManager.setSheddingThreshold(std::min(threshold, priority));
+}
+
+const std::vector<int>& DataChannel::getProcessorPriorities() const {
+    return processesManager.getProcessorPriorities();
+}
+
+size_t DataChannel::getProcessorBudgetMisses() const {
+    return processesManager.getBudgetMissesLastRun();
+}
+
+ChannelMetrics& DataChannel::getMetrics() const {
+    return *metrics;
 }
 
 int DataChannel::getTickTime() const {
@@ -3,11 +3,15 @@
 #include "processors/GeneralProcessorFactory.h"
 #include "processors/GeneralProcessor.h"
 #include "processors/CommandProcessor.h"
+#include "processors/StreamingCommandProcessor.h"
+#include "processors/FileWatchProcessor.h"
 #include "processors/MidasEventProcessor.h"
 #include "processors/MidasOdbProcessor.h"
 #include "command_management/CommandRunner.h"
+#include "receivers/MidasReceiverProvider.h"
 #include "utilities/TypeChecker.h"
 #include <algorithm>
+#include <chrono>
 #include <iostream>
 //#include <spdlog/spdlog.h>
 
@@ -19,10 +23,24 @@ const int DEFAULT_EVENTS_IN_CIRCULAR_BUFFER      = 1;
 const std::string DEFAULT_ZMQ_ADDRESS            = "tcp://127.0.0.1:5555";
 const int DEFAULT_PERIOD_MS                      = 1000;
 const std::string DEFAULT_COMMAND_STRING         = "";
+const size_t DEFAULT_COMMAND_MAX_OUTPUT_BYTES    = 16 * 1024 * 1024;
 const bool DEFAULT_ENABLED_VALUE                 = true;
+const bool DEFAULT_SNAPSHOT_ON_CONNECT           = false;
+const double DEFAULT_MESSAGES_PER_SECOND         = 0;
+const double DEFAULT_MESSAGE_BURST               = 1;
+const double DEFAULT_BYTES_PER_SECOND            = 0;
+const int DEFAULT_PRIORITY                       = 0;
+const int DEFAULT_LATENCY_BUDGET_MS              = 0;
+const bool DEFAULT_PUBLISH_ON_CHANGE             = false;
+const int DEFAULT_MAX_SILENCE_MS                 = 10000;
+const double DEFAULT_BUFFER_BUDGET_MB            = 0;
 
 DataChannelManager::DataChannelManager(const nlohmann::json& channelConfig, int verbose)
-    : verbose(verbose) {
+    : globalTickTime(0), verbose(verbose), loopCount(0), bufferByteBudget(0), peakBufferBytes(0),
+      bufferBytesGauge(&MetricsRegistry::Instance().gauge(
+          "publisher_buffer_bytes", "Payload bytes held across all channel buffers")),
+      peakBufferBytesGauge(&MetricsRegistry::Instance().gauge(
+          "publisher_buffer_peak_bytes", "Most payload bytes ever held across all channel buffers")) {
     for (auto it = channelConfig.begin(); it != channelConfig.end(); ++it) {
         const std::string& channelId = it.key();
         const nlohmann::json& channelData = it.value();
@@ -33,19 +51,106 @@ DataChannelManager::DataChannelManager(const nlohmann::json& channelConfig, int
 
 bool DataChannelManager::publish() {
     bool success = true;
+    int threshold = loadShedder.getThreshold();
+    bool decimationTick = loopCount % loadShedder.getChannelDecimation() == 0;
+    size_t budgetMisses = 0;
+    size_t residentBytes = getBufferResidentBytes();
+    size_t fairShare = channels.empty() ? 0 : bufferByteBudget / channels.size();
+    auto loopStart = std::chrono::steady_clock::now();
 
     for (auto& channelPair : channels) {
-        if (!channelPair.second.publish()) {
+        DataChannel& channel = channelPair.second;
+        if (loadShedder.isShed(channel.getPriority()) && !decimationTick) {
+            channel.getMetrics().publishesShed->add();
+            continue;
+        }
+        channel.setSheddingThreshold(threshold);
+
+        size_t ownBytes = channel.getBufferResidentBytes();
+        if (bufferByteBudget > 0) {
+            // A channel may always keep its fair share, and more while the others leave room
+            size_t otherBytes = residentBytes - ownBytes;
+            size_t room = bufferByteBudget > otherBytes ? bufferByteBudget - otherBytes : 0;
+            channel.limitBufferBytes(std::max<size_t>({fairShare, room, 1}));
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        if (!channel.publish()) {
             success = false;
             spdlog::warn("Channel {} has failed to publish. [{}:{}]",
                          channelPair.first, __FILE__, __LINE__);
-            channelPair.second.printAttributes();
+            channel.printAttributes();
         }
+
+        residentBytes = residentBytes - ownBytes + channel.getBufferResidentBytes();
+
+        budgetMisses += channel.getProcessorBudgetMisses();
+        int budgetMs = channel.getLatencyBudget();
+        if (budgetMs > 0 && std::chrono::steady_clock::now() - start > std::chrono::milliseconds(budgetMs)) {
+            channel.getMetrics().latencyBudgetMisses->add();
+            ++budgetMisses;
+        }
+    }
+    ++loopCount;
+
+    peakBufferBytes = std::max(peakBufferBytes, residentBytes);
+    bufferBytesGauge->set(static_cast<int64_t>(residentBytes));
+    peakBufferBytesGauge->set(static_cast<int64_t>(peakBufferBytes));
+
+    if (loadShedder.isEnabled()) {
+        LoadSample sample;
+        sample.loopMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loopStart).count();
+        sample.tickMs = globalTickTime;
+        sample.budgetMisses = budgetMisses;
+        sample.receiverFill = getReceiverFill();
+        loadShedder.update(sample);
     }
 
     return success;
 }
 
+void DataChannelManager::configureLoadShedding(const nlohmann::json& config) {
+    loadShedder.configure(config);
+
+    std::vector<int> priorities;
+    for (const auto& channelPair : channels) {
+        priorities.push_back(channelPair.second.getPriority());
+        const std::vector<int>& processorPriorities = channelPair.second.getProcessorPriorities();
+        priorities.insert(priorities.end(), processorPriorities.begin(), processorPriorities.end());
+    }
+    loadShedder.setPriorities(priorities);
+
+    if (loadShedder.isEnabled()) {
+        spdlog::info("Load shedding enabled across {} channel(s)", channels.size());
+    }
+}
+
+void DataChannelManager::setBufferByteBudget(size_t bytes) {
+    bufferByteBudget = bytes;
+    if (bytes > 0) {
+        spdlog::info("Limiting channel buffers to {} bytes across {} channel(s)", bytes, channels.size());
+    }
+}
+
+size_t DataChannelManager::getBufferResidentBytes() const {
+    size_t bytes = 0;
+    for (const auto& channelPair : channels) {
+        bytes += channelPair.second.getBufferResidentBytes();
+    }
+    return bytes;
+}
+
+double DataChannelManager::getReceiverFill() const {
+    MidasReceiverProvider& provider = MidasReceiverProvider::Instance();
+    if (!provider.hasFanOut()) {
+        return 0.0;
+    }
+    // Only pulls events received since the last poll, which the consumers would pull anyway
+    EventFanOut& fanOut = provider.getFanOut();
+    fanOut.poll();
+    return fanOut.getFill();
+}
+
 DataChannel* DataChannelManager::getChannel(const std::string& channelId) {
     auto it = channels.find(channelId);
     if (it != channels.end()) {
@@ -82,15 +187,56 @@ void DataChannelManager::addChannel(const std::string& channelId, const nlohmann
     std::string zmq_address = getOrDefault(channelConfig, "zmq-address", std::string(DEFAULT_ZMQ_ADDRESS), channelId, "channel config");
     int eventsInCircularBuffer = getOrDefault(channelConfig, "num-events-in-circular-buffer", DEFAULT_EVENTS_IN_CIRCULAR_BUFFER, channelId, "channel config");
 
+    bool snapshotOnConnect = getOrDefault(channelConfig, "snapshot-on-connect", DEFAULT_SNAPSHOT_ON_CONNECT, channelId, "channel config", false);
+    int channelPriority = getOrDefault(channelConfig, "priority", DEFAULT_PRIORITY, channelId, "channel config", false);
+    int channelLatencyBudget = getOrDefault(channelConfig, "latency-budget-ms", DEFAULT_LATENCY_BUDGET_MS, channelId, "channel config", false);
+    double bufferBudgetMb = getOrDefault(channelConfig, "buffer-budget-mb", DEFAULT_BUFFER_BUDGET_MB, channelId, "channel config", false);
+    bool channelPublishOnChange = getOrDefault(channelConfig, "publish-on-change", DEFAULT_PUBLISH_ON_CHANGE, channelId, "channel config", false);
+    int channelMaxSilence = getOrDefault(channelConfig, "max-silence-ms", DEFAULT_MAX_SILENCE_MS, channelId, "channel config", false);
+
+    // Rate control replaces publish-N-ignore-M decimation
+    const nlohmann::json& rateControl = channelConfig.contains("rate-control") && channelConfig["rate-control"].is_object()
+        ? channelConfig["rate-control"]
+        : nlohmann::json::object();
+    double messagesPerSecond = getOrDefault(rateControl, "messages-per-second", DEFAULT_MESSAGES_PER_SECOND, channelId, "rate-control", false);
+    double messageBurst = getOrDefault(rateControl, "message-burst", DEFAULT_MESSAGE_BURST, channelId, "rate-control", false);
+    double bytesPerSecond = getOrDefault(rateControl, "bytes-per-second", DEFAULT_BYTES_PER_SECOND, channelId, "rate-control", false);
+    double byteBurst = getOrDefault(rateControl, "byte-burst", bytesPerSecond, channelId, "rate-control", false);
+    bool rateControlled = messagesPerSecond > 0 || bytesPerSecond > 0;
+    if (rateControlled && publishesIgnoredAfterBatch > 0) {
+        spdlog::warn("Channel {} is rate controlled, ignoring publishes-per-batch and publishes-ignored-after-batch [{}:{}]",
+                     channelId, __FILE__, __LINE__);
+        publishesPerBatch = DEFAULT_PUBLISHES_PER_BATCH;
+        publishesIgnoredAfterBatch = DEFAULT_PUBLISHES_IGNORED_AFTER_BATCH;
+    }
+
     DataChannel dataChannel(name, publishesPerBatch, publishesIgnoredAfterBatch, zmq_address);
+    if (rateControlled) {
+        dataChannel.setRateLimit(messagesPerSecond, messageBurst, bytesPerSecond, byteBurst);
+    }
+    if (snapshotOnConnect && !dataChannel.enableSnapshotOnConnect()) {
+        spdlog::warn("Failed to enable snapshot-on-connect for channel {} [{}:{}]",
+                     channelId, __FILE__, __LINE__);
+    }
+    dataChannel.setPriority(channelPriority);
+    dataChannel.setLatencyBudget(channelLatencyBudget);
     DataChannelProcessesManager processesManager(eventsInCircularBuffer + 1, verbose);
     dataChannel.setDataChannelProcessesManager(processesManager);
+    dataChannel.setBufferByteBudget(static_cast<size_t>(std::max(bufferBudgetMb, 0.0) * 1024 * 1024));
 
     if (channelConfig.contains("processors")) {
+        size_t processorIndex = 0;
         for (const auto& processorConfig : channelConfig["processors"]) {
             GeneralProcessor* processor = nullptr;
+            // Position in the channel's processor list, stable however the channels are ordered
+            std::string processorName = channelId + "/" + std::to_string(processorIndex++);
 
             std::string processorType = getOrDefault(processorConfig, "processor", std::string("GeneralProcessor"), channelId, "processor config");
+            int processorPriority = getOrDefault(processorConfig, "priority", channelPriority, channelId, "processor config", false);
+            int processorLatencyBudget = getOrDefault(processorConfig, "latency-budget-ms", DEFAULT_LATENCY_BUDGET_MS, channelId, "processor config", false);
+            bool publishOnChange = getOrDefault(processorConfig, "publish-on-change", channelPublishOnChange, channelId, "processor config", false);
+            int maxSilence = getOrDefault(processorConfig, "max-silence-ms", channelMaxSilence, channelId, "processor config", false);
+            int processorMaxSilence = publishOnChange ? std::max(maxSilence, 0) : -1;
             processor = factory.CreateProcessor(processorType);
 
             if (!processor) {
@@ -122,12 +268,12 @@ void DataChannelManager::addChannel(const std::string& channelId, const nlohmann
                         ? processorConfig["midas_event_processor_config"]
                         : nlohmann::json::object();
 
-                midasProcessor->Init(midas_receiver_config, pipeline_config, event_processor_config);
+                midasProcessor->Init(midas_receiver_config, pipeline_config, event_processor_config, processorName);
 
                 int periodMs = getOrDefault(processorConfig, "period-ms", DEFAULT_PERIOD_MS, channelId, "processor config");
                 midasProcessor->setPeriod(periodMs);
 
-                dataChannel.addProcessToManager(midasProcessor);
+                dataChannel.addProcessToManager(midasProcessor, processorType, processorPriority, processorLatencyBudget, processorMaxSilence);
             }
             else if (TypeChecker::IsInstanceOf<MidasOdbProcessor>(processor)) {
                 auto* odbProcessor = dynamic_cast<MidasOdbProcessor*>(processor);
@@ -151,7 +297,53 @@ void DataChannelManager::addChannel(const std::string& channelId, const nlohmann
                 int periodMs = getOrDefault(processorConfig, "period-ms", DEFAULT_PERIOD_MS, channelId, "processor config");
                 odbProcessor->setPeriod(periodMs);
 
-                dataChannel.addProcessToManager(odbProcessor);
+                dataChannel.addProcessToManager(odbProcessor, processorType, processorPriority, processorLatencyBudget, processorMaxSilence);
+            }
+            else if (TypeChecker::IsInstanceOf<StreamingCommandProcessor>(processor)) {
+                auto* streamingProcessor = dynamic_cast<StreamingCommandProcessor*>(processor);
+                if (!streamingProcessor) {
+                    spdlog::warn("Failed to cast to StreamingCommandProcessor in channel {} [{}:{}]",
+                                 channelId, __FILE__, __LINE__);
+                    delete processor;
+                    continue;
+                }
+
+                try {
+                    streamingProcessor->Init(processorConfig);
+                } catch (const std::exception& e) {
+                    spdlog::warn("Failed to initialize StreamingCommandProcessor in channel {}: {} [{}:{}]",
+                                 channelId, e.what(), __FILE__, __LINE__);
+                    delete processor;
+                    continue;
+                }
+
+                int periodMs = getOrDefault(processorConfig, "period-ms", DEFAULT_PERIOD_MS, channelId, "processor config");
+                streamingProcessor->setPeriod(periodMs);
+
+                dataChannel.addProcessToManager(streamingProcessor, processorType, processorPriority, processorLatencyBudget, processorMaxSilence);
+            }
+            else if (TypeChecker::IsInstanceOf<FileWatchProcessor>(processor)) {
+                auto* fileWatchProcessor = dynamic_cast<FileWatchProcessor*>(processor);
+                if (!fileWatchProcessor) {
+                    spdlog::warn("Failed to cast to FileWatchProcessor in channel {} [{}:{}]",
+                                 channelId, __FILE__, __LINE__);
+                    delete processor;
+                    continue;
+                }
+
+                try {
+                    fileWatchProcessor->Init(processorConfig);
+                } catch (const std::exception& e) {
+                    spdlog::warn("Failed to initialize FileWatchProcessor in channel {}: {} [{}:{}]",
+                                 channelId, e.what(), __FILE__, __LINE__);
+                    delete processor;
+                    continue;
+                }
+
+                int periodMs = getOrDefault(processorConfig, "period-ms", DEFAULT_PERIOD_MS, channelId, "processor config");
+                fileWatchProcessor->setPeriod(periodMs);
+
+                dataChannel.addProcessToManager(fileWatchProcessor, processorType, processorPriority, processorLatencyBudget, processorMaxSilence);
             }
             else if (TypeChecker::IsInstanceOf<CommandProcessor>(processor)) {
                 auto* commandProcessor = dynamic_cast<CommandProcessor*>(processor);
@@ -164,18 +356,28 @@ void DataChannelManager::addChannel(const std::string& channelId, const nlohmann
 
                 std::string commandString = getOrDefault(processorConfig, "command", std::string(DEFAULT_COMMAND_STRING), channelId, "processor config");
 
+                // With "args", the command is the program itself and nothing is split or run by a shell
                 CommandRunner commandRunner(commandString);
+                if (processorConfig.contains("args") && processorConfig["args"].is_array()) {
+                    std::vector<std::string> commandWithArgs = {commandString};
+                    for (const auto& arg : processorConfig["args"]) {
+                        commandWithArgs.push_back(arg.is_string() ? arg.get<std::string>() : arg.dump());
+                    }
+                    commandRunner = CommandRunner(commandWithArgs);
+                }
+                size_t maxOutputBytes = getOrDefault(processorConfig, "max-output-bytes", DEFAULT_COMMAND_MAX_OUTPUT_BYTES, channelId, "processor config", false);
+                commandRunner.setOutputLimit(maxOutputBytes);
                 commandProcessor->setCommandRunner(commandRunner);
 
                 int periodMs = getOrDefault(processorConfig, "period-ms", DEFAULT_PERIOD_MS, channelId, "processor config");
                 commandProcessor->setPeriod(periodMs);
 
-                dataChannel.addProcessToManager(commandProcessor);
+                dataChannel.addProcessToManager(commandProcessor, processorType, processorPriority, processorLatencyBudget, processorMaxSilence);
             }
             else {
                 int periodMs = getOrDefault(processorConfig, "period-ms", DEFAULT_PERIOD_MS, channelId, "processor config");
                 processor->setPeriod(periodMs);
-                dataChannel.addProcessToManager(processor);
+                dataChannel.addProcessToManager(processor, processorType, processorPriority, processorLatencyBudget, processorMaxSilence);
             }
         }
     }
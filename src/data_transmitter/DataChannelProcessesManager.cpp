@@ -1,34 +1,121 @@
 #include "data_transmitter/DataChannelProcessesManager.h"
+#include "utilities/Hash.h"
 #include <algorithm> // Include for std::gcd
+#include <chrono>
+#include <climits>
 
 const int DEFAULT_PROCESSOR_PERIOD = 1000;
 
 DataChannelProcessesManager::DataChannelProcessesManager(size_t bufferSize, int verbose)
-    : dataBuffer(bufferSize), verbose(verbose), processorPeriodsGcd(DEFAULT_PROCESSOR_PERIOD) {
+    : entriesAddedLastRun(0), entriesSuppressedLastRun(0), budgetMissesLastRun(0), sheddingThreshold(INT_MIN), dataBuffer(bufferSize),
+      verbose(verbose), processorPeriodsGcd(DEFAULT_PROCESSOR_PERIOD) {
 }
 
-void DataChannelProcessesManager::addProcessor(GeneralProcessor* processor) {
+void DataChannelProcessesManager::addProcessor(GeneralProcessor* processor, ProcessorMetrics* metrics, int priority,
+                                               int latencyBudgetMs, int maxSilenceMs) {
     processors.push_back(processor);
+    processorMetrics.push_back(metrics);
+    processorPriorities.push_back(priority);
+    processorLatencyBudgets.push_back(latencyBudgetMs);
+    processorMaxSilences.push_back(maxSilenceMs);
+    lastOutputHashes.push_back(0);
+    lastOutputTimes.push_back(std::chrono::steady_clock::time_point::min());
+}
+
+size_t DataChannelProcessesManager::getProcessorCount() const {
+    return processors.size();
+}
+
+size_t DataChannelProcessesManager::getEntriesAddedLastRun() const {
+    return entriesAddedLastRun;
+}
+
+size_t DataChannelProcessesManager::getEntriesSuppressedLastRun() const {
+    return entriesSuppressedLastRun;
+}
+
+size_t DataChannelProcessesManager::getBudgetMissesLastRun() const {
+    return budgetMissesLastRun;
+}
+
+void DataChannelProcessesManager::setSheddingThreshold(int threshold) {
+    sheddingThreshold = threshold;
+}
+
+const std::vector<int>& DataChannelProcessesManager::getProcessorPriorities() const {
+    return processorPriorities;
 }
 
 bool DataChannelProcessesManager::runProcesses() {
-    bool addedNewData = false;
-    for (const auto processor : processors) {
+    entriesAddedLastRun = 0;
+    entriesSuppressedLastRun = 0;
+    budgetMissesLastRun = 0;
+    for (size_t i = 0; i < processors.size(); ++i) {
+        GeneralProcessor* processor = processors[i];
         if (processor->isReadyToProcess()) {
+            if (processorPriorities[i] < sheddingThreshold) {
+                if (ProcessorMetrics* metrics = processorMetrics[i]) {
+                    metrics->runsShed->add();
+                }
+                continue;
+            }
+
+            auto start = std::chrono::steady_clock::now();
             std::vector<std::string> processedOutput = processor->getProcessedOutput();
-            for (const auto& output : processedOutput) {
-                addedNewData = true;
-                dataBuffer.Push(output);
+
+            uint64_t processingNs = elapsedNanoseconds(start);
+            int budgetMs = processorLatencyBudgets[i] > 0 ? processorLatencyBudgets[i] : processor->getPeriod();
+            bool overBudget = processingNs > static_cast<uint64_t>(budgetMs) * 1000000;
+            if (overBudget) {
+                ++budgetMissesLastRun;
+            }
+
+            if (ProcessorMetrics* metrics = processorMetrics[i]) {
+                metrics->processingTime->record(processingNs);
+                if (overBudget) {
+                    metrics->deadlineMisses->add();
+                }
+                metrics->runs->add();
+                metrics->outputs->add(processedOutput.size());
+                for (const auto& output : processedOutput) {
+                    metrics->outputBytes->add(output.size());
+                }
             }
+
+            if (processorMaxSilences[i] >= 0 && !processedOutput.empty() && !isOutputDue(i, processedOutput)) {
+                if (ProcessorMetrics* metrics = processorMetrics[i]) {
+                    metrics->outputsSuppressed->add(processedOutput.size());
+                }
+                entriesSuppressedLastRun += processedOutput.size();
+                continue;
+            }
+
+            for (auto& output : processedOutput) {
+                dataBuffer.Push(std::move(output));
+            }
+            entriesAddedLastRun += processedOutput.size();
+        }
+    }
+    return entriesAddedLastRun > 0;
+}
+
+bool DataChannelProcessesManager::hasReadyProcessor() const {
+    for (size_t i = 0; i < processors.size(); ++i) {
+        if (processorPriorities[i] >= sheddingThreshold && processors[i]->isReadyToProcess()) {
+            return true;
         }
     }
-    return addedNewData;
+    return false;
 }
 
 const DataBuffer<std::string>& DataChannelProcessesManager::getDataBuffer() const {
     return dataBuffer;
 }
 
+void DataChannelProcessesManager::setBufferByteBudget(size_t bytes) {
+    dataBuffer.SetByteBudget(bytes);
+}
+
 // Update the processorPeriodsGcd member variable
 void DataChannelProcessesManager::updateProcessorPeriodsGCD() {
     processorPeriodsGcd = findGCDOfProcessorPeriods();
@@ -54,3 +141,23 @@ int DataChannelProcessesManager::findGCDOfProcessorPeriods() {
 
     return gcd;
 }
+
+bool DataChannelProcessesManager::isOutputDue(size_t index, const std::vector<std::string>& output) {
+    // Chain the entries through the seed, so their order and boundaries count as well
+    uint64_t hash = output.size();
+    for (const auto& entry : output) {
+        hash = xxHash64(entry, hash);
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    bool neverSent = lastOutputTimes[index] == std::chrono::steady_clock::time_point::min();
+    int maxSilenceMs = processorMaxSilences[index];
+    if (!neverSent && hash == lastOutputHashes[index] &&
+        (maxSilenceMs == 0 || now - lastOutputTimes[index] < std::chrono::milliseconds(maxSilenceMs))) {
+        return false;
+    }
+
+    lastOutputHashes[index] = hash;
+    lastOutputTimes[index] = now;
+    return true;
+}
@@ -1,8 +1,12 @@
 #include "data_transmitter/DataTransmitter.h"
+#include "metrics/Metrics.h"
+#include "metrics/EventTracer.h"
 #include <spdlog/spdlog.h>
+#include <chrono>
 
 DataTransmitter::DataTransmitter(const std::string& zmqAddress, int verbose)
-    : context(1), publisher(context, ZMQ_PUB), zmqAddress(zmqAddress), verbose(verbose), isBoundToSocket(false) {
+    : context(1), publisher(context, ZMQ_PUB), zmqAddress(zmqAddress), verbose(verbose), isBoundToSocket(false),
+      lastValueCacheEnabled(false) {
     // Constructor initializes ZeroMQ socket
 }
 
@@ -28,58 +32,186 @@ bool DataTransmitter::isBound() {
 }
 
 bool DataTransmitter::publish(DataChannel& dataChannel, const std::string& data) {
+    if (!admit(dataChannel)) {
+        return true;
+    }
+    return sendToChannel(dataChannel, std::make_shared<const std::string>(data));
+}
+
+bool DataTransmitter::publish(DataChannel& dataChannel, std::string&& data) {
+    if (!admit(dataChannel)) {
+        return true;
+    }
+    return sendToChannel(dataChannel, std::make_shared<const std::string>(std::move(data)));
+}
+
+bool DataTransmitter::sendToChannel(DataChannel& dataChannel, std::shared_ptr<const std::string> payload) {
+    ChannelMetrics& metrics = dataChannel.getMetrics();
     try {
-        std::string channel = dataChannel.getName();
-        dataChannel.seen();
-        if (verbose > 0) {
-            std::string channelDetails;
-            channelDetails += "Channel Name: " + channel + "\n";
-            channelDetails += "Events Before Break: " + std::to_string(dataChannel.getEventsBeforeBreak()) + "\n";
-            channelDetails += "Events To Ignore In Break: " + std::to_string(dataChannel.getEventsToIgnoreInBreak()) + "\n";
-            channelDetails += "Events Published: " + std::to_string(dataChannel.getEventsPublished()) + "\n";
-            channelDetails += "Events Seen: " + std::to_string(dataChannel.getEventsSeen()) + "\n";
-            
-            if (dataChannel.isOnBreak()) {
-                int eventsOnBreak = dataChannel.getEventsToIgnoreInBreak() - dataChannel.getEventsSeenOnBreak();
-                channelDetails += channel + " is on a break for " + std::to_string(eventsOnBreak) + " events\n";
-            }
-            spdlog::debug(channelDetails);
+        // Log before handing off: zmq frees the buffer as soon as it has been sent
+        logPublish(dataChannel, payload);
+
+        size_t bytes = payload->size();
+        auto start = std::chrono::steady_clock::now();
+        sendPayload(dataChannel.getName(), std::move(payload));
+        metrics.sendTime->record(elapsedNanoseconds(start));
+
+        EventTracer& tracer = EventTracer::Instance();
+        if (tracer.hasOpenTraces()) {
+            tracer.recordOpen("zmq_send", EventTracer::toNanoseconds(start), EventTracer::now());
         }
+        metrics.messagesPublished->add();
+        metrics.bytesPublished->add(bytes);
+
+        dataChannel.published();
+        return true;
+    } catch (const zmq::error_t& e) {
+        metrics.sendErrors->add();
+        spdlog::error("Failed to send data to address {}: {}", zmqAddress, e.what());
+        return false;
+    }
+}
+
+bool DataTransmitter::publish(const std::string& topic, std::shared_ptr<const std::string> payload) {
+    if (!isBoundToSocket && !bind()) {
+        return false;
+    }
+    try {
+        sendPayload(topic, std::move(payload));
+        return true;
+    } catch (const zmq::error_t& e) {
+        spdlog::error("Failed to send data to address {}: {}", zmqAddress, e.what());
+        return false;
+    }
+}
+
+void DataTransmitter::setRecorder(std::shared_ptr<StreamRecorder> newRecorder) {
+    recorder = std::move(newRecorder);
+}
+
+void DataTransmitter::setPayloadInspector(std::shared_ptr<PayloadInspector> inspector) {
+    payloadInspector = std::move(inspector);
+}
+
+bool DataTransmitter::admit(DataChannel& dataChannel) {
+    dataChannel.seen();
+    // Checking the level first means nothing is formatted unless it will be written
+    if (verbose > 0 && spdlog::should_log(spdlog::level::debug)) {
+        const std::string& channel = dataChannel.getName();
+        spdlog::debug("Channel Name: {}\nEvents Before Break: {}\nEvents To Ignore In Break: {}\n"
+                      "Events Published: {}\nEvents Seen: {}",
+                      channel, dataChannel.getEventsBeforeBreak(), dataChannel.getEventsToIgnoreInBreak(),
+                      dataChannel.getEventsPublished(), dataChannel.getEventsSeen());
 
         if (dataChannel.isOnBreak()) {
-            return true;
+            int eventsOnBreak = dataChannel.getEventsToIgnoreInBreak() - dataChannel.getEventsSeenOnBreak();
+            spdlog::debug("{} is on a break for {} events", channel, eventsOnBreak);
         }
+    }
 
-        if (!channel.empty()) {
-            zmq::message_t channelMessage(channel.size());
-            memcpy(channelMessage.data(), channel.c_str(), channel.size());
-            publisher.send(channelMessage, zmq::send_flags::sndmore);
-        }
+    if (dataChannel.isOnBreak()) {
+        dataChannel.getMetrics().messagesSkipped->add();
+        return false;
+    }
+    return true;
+}
 
-        zmq::message_t message(data.size());
-        memcpy(message.data(), data.c_str(), data.size());
-        publisher.send(message, zmq::send_flags::none);
+void DataTransmitter::sendPayload(const std::string& channel, std::shared_ptr<const std::string> payload) {
+    if (lastValueCacheEnabled) {
+        lastValues[channel] = payload;
+    }
+    if (recorder) {
+        recorder->record(zmqAddress, channel, payload);
+    }
+    sendFrames(channel, payload);
+}
 
-        dataChannel.published();
+void DataTransmitter::sendFrames(const std::string& channel, const std::shared_ptr<const std::string>& payload) {
+    if (!channel.empty()) {
+        zmq::message_t channelMessage(channel.data(), channel.size());
+        publisher.send(channelMessage, zmq::send_flags::sndmore);
+    }
 
-        if (verbose > 2) {
-            spdlog::debug("Published to channel {} at address {}: {}", channel, zmqAddress, data);
-        } else if (verbose > 1) {
-            if (data.length() > 1000) {
-                std::string truncatedData = data.substr(0, 1000);
-                spdlog::debug("Published to channel {} at address {}: {}... <truncated> ...", channel, zmqAddress, truncatedData);
-            } else {
-                spdlog::debug("Published to channel {} at address {}: {}", channel, zmqAddress, data);
-            }
-        } else if (verbose > 0) {
-            spdlog::debug("Published to channel {} at address {}", channel, zmqAddress);
-        }
+    // zmq owns a reference to the payload until it has gone out on the wire
+    auto* reference = new std::shared_ptr<const std::string>(payload);
+    zmq::message_t message(const_cast<char*>(payload->data()), payload->size(),
+                           [](void*, void* hint) { delete static_cast<std::shared_ptr<const std::string>*>(hint); },
+                           reference);
+    publisher.send(message, zmq::send_flags::none);
+}
 
+bool DataTransmitter::enableLastValueCache() {
+    if (lastValueCacheEnabled) {
         return true;
-    } catch (const zmq::error_t& e) {
-        spdlog::error("Failed to send data to address {}: {}", zmqAddress, e.what());
+    }
+    if (isBoundToSocket) {
+        spdlog::warn("Cannot enable last-value cache on {}: socket is already bound", zmqAddress);
         return false;
     }
+
+    publisher = zmq::socket_t(context, ZMQ_XPUB);
+    // Deliver every subscription, not just the first per topic, so each joiner gets a snapshot
+    publisher.set(zmq::sockopt::xpub_verbose, 1);
+    lastValueCacheEnabled = true;
+    return true;
+}
+
+bool DataTransmitter::hasLastValueCache() const {
+    return lastValueCacheEnabled;
+}
+
+size_t DataTransmitter::serviceSubscriptions() {
+    if (!lastValueCacheEnabled || !isBoundToSocket) {
+        return 0;
+    }
+
+    size_t replayed = 0;
+    try {
+        zmq::message_t subscription;
+        while (publisher.recv(subscription, zmq::recv_flags::dontwait)) {
+            const char* bytes = static_cast<const char*>(subscription.data());
+            // First byte is 1 for subscribe, 0 for unsubscribe; the rest is the topic prefix
+            if (subscription.size() == 0 || bytes[0] != 1) {
+                continue;
+            }
+            std::string prefix(bytes + 1, subscription.size() - 1);
+
+            size_t replayedForPrefix = 0;
+            for (const auto& [topic, payload] : lastValues) {
+                if (topic.compare(0, prefix.size(), prefix) == 0) {
+                    sendFrames(topic, payload);
+                    ++replayedForPrefix;
+                }
+            }
+            replayed += replayedForPrefix;
+
+            if (verbose > 0) {
+                spdlog::debug("New subscription '{}' on {}, replayed {} cached message(s)", prefix, zmqAddress,
+                              replayedForPrefix);
+            }
+        }
+    } catch (const zmq::error_t& e) {
+        spdlog::error("Failed to service subscriptions on {}: {}", zmqAddress, e.what());
+    }
+    return replayed;
+}
+
+void* DataTransmitter::getSocketHandle() {
+    return publisher.handle();
+}
+
+zmq::context_t& DataTransmitter::getContext() {
+    return context;
+}
+
+void DataTransmitter::logPublish(const DataChannel& dataChannel, const std::shared_ptr<const std::string>& payload) const {
+    // Payload contents are only logged for the messages the inspector samples
+    if (payloadInspector) {
+        payloadInspector->inspect(zmqAddress, dataChannel.getName(), payload);
+    }
+    if (verbose > 0 && spdlog::should_log(spdlog::level::debug)) {
+        spdlog::debug("Published to channel {} at address {} ({} bytes)", dataChannel.getName(), zmqAddress, payload->size());
+    }
 }
 
 void DataTransmitter::setVerbose(int verboseLevel) {
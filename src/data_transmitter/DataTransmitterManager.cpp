@@ -1,4 +1,9 @@
 #include "data_transmitter/DataTransmitterManager.h"
+#include <spdlog/spdlog.h>
+#include <cerrno>
+#include <chrono>
+#include <thread>
+#include <vector>
 
 DataTransmitterManager::DataTransmitterManager(int verbose) : verbose(verbose) {}
 
@@ -14,6 +19,8 @@ DataTransmitterManager::~DataTransmitterManager() {
 void DataTransmitterManager::addZmqAddress(const std::string& zmqAddress) {
     if (transmitterMap.find(zmqAddress) == transmitterMap.end()) {
         transmitterMap[zmqAddress] = std::make_shared<DataTransmitter>(zmqAddress, verbose);
+        transmitterMap[zmqAddress]->setRecorder(recorder);
+        transmitterMap[zmqAddress]->setPayloadInspector(payloadInspector);
     }
 }
 
@@ -33,3 +40,59 @@ std::shared_ptr<DataTransmitter> DataTransmitterManager::getTransmitter(const st
 void DataTransmitterManager::setVerbose(int enableVerbose) {
     verbose = enableVerbose;
 }
+
+void DataTransmitterManager::waitForSubscriptions(int milliseconds) {
+    std::vector<zmq::pollitem_t> items;
+    std::vector<DataTransmitter*> owners;
+    for (auto& transmitterPair : transmitterMap) {
+        auto& transmitter = transmitterPair.second;
+        if (transmitter->hasLastValueCache() && transmitter->isBound()) {
+            items.push_back({transmitter->getSocketHandle(), 0, ZMQ_POLLIN, 0});
+            owners.push_back(transmitter.get());
+        }
+    }
+
+    if (items.empty()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+        return;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(milliseconds);
+    do {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (remaining.count() < 0) {
+            remaining = std::chrono::milliseconds(0);
+        }
+
+        try {
+            zmq::poll(items.data(), items.size(), remaining);
+        } catch (const zmq::error_t& e) {
+            // A signal interrupts the poll; return so the caller can act on it
+            if (e.num() == EINTR) {
+                return;
+            }
+            spdlog::error("Failed to wait for subscriptions: {}", e.what());
+            return;
+        }
+        for (size_t i = 0; i < items.size(); ++i) {
+            if (items[i].revents & ZMQ_POLLIN) {
+                owners[i]->serviceSubscriptions();
+            }
+        }
+    } while (std::chrono::steady_clock::now() < deadline);
+}
+
+void DataTransmitterManager::setRecorder(std::shared_ptr<StreamRecorder> newRecorder) {
+    recorder = std::move(newRecorder);
+    for (auto& transmitterPair : transmitterMap) {
+        transmitterPair.second->setRecorder(recorder);
+    }
+}
+
+void DataTransmitterManager::setPayloadInspector(std::shared_ptr<PayloadInspector> inspector) {
+    payloadInspector = std::move(inspector);
+    for (auto& transmitterPair : transmitterMap) {
+        transmitterPair.second->setPayloadInspector(payloadInspector);
+    }
+}
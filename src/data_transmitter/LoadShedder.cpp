@@ -0,0 +1,109 @@
+#include "data_transmitter/LoadShedder.h"
+#include "metrics/MetricsRegistry.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+
+const int DEFAULT_OVERLOAD_LOOPS = 3;
+const int DEFAULT_RECOVERY_LOOPS = 50;
+const double DEFAULT_RECOVERY_HEADROOM = 0.5;
+const double DEFAULT_RECEIVER_FILL_THRESHOLD = 0.8;
+const int DEFAULT_CHANNEL_DECIMATION = 10;
+
+LoadShedder::LoadShedder()
+    : enabled(false), overloadLoops(DEFAULT_OVERLOAD_LOOPS), recoveryLoops(DEFAULT_RECOVERY_LOOPS),
+      recoveryHeadroom(DEFAULT_RECOVERY_HEADROOM), receiverFillThreshold(DEFAULT_RECEIVER_FILL_THRESHOLD),
+      channelDecimation(DEFAULT_CHANNEL_DECIMATION), stage(0), laggingLoops(0), healthyLoops(0) {
+    MetricsRegistry& registry = MetricsRegistry::Instance();
+    stageGauge = &registry.gauge("publisher_load_shedding_stage", "Number of priorities currently shed");
+    shedDecisions = &registry.counter("publisher_load_shedding_decisions_total", "Load-shedding threshold changes",
+                                      {{"direction", "shed"}});
+    recoverDecisions = &registry.counter("publisher_load_shedding_decisions_total", "Load-shedding threshold changes",
+                                         {{"direction", "recover"}});
+}
+
+void LoadShedder::configure(const nlohmann::json& config) {
+    enabled = config.value("enabled", false);
+    overloadLoops = std::max(1, config.value("overload-loops", DEFAULT_OVERLOAD_LOOPS));
+    recoveryLoops = std::max(1, config.value("recovery-loops", DEFAULT_RECOVERY_LOOPS));
+    recoveryHeadroom = std::clamp(config.value("recovery-headroom", DEFAULT_RECOVERY_HEADROOM), 0.0, 1.0);
+    receiverFillThreshold = config.value("receiver-fill-threshold", DEFAULT_RECEIVER_FILL_THRESHOLD);
+    channelDecimation = std::max(1, config.value("channel-decimation", DEFAULT_CHANNEL_DECIMATION));
+}
+
+void LoadShedder::setPriorities(const std::vector<int>& priorities) {
+    levels = priorities;
+    std::sort(levels.begin(), levels.end());
+    levels.erase(std::unique(levels.begin(), levels.end()), levels.end());
+    stage = 0;
+    stageGauge->set(0);
+}
+
+bool LoadShedder::isEnabled() const {
+    return enabled;
+}
+
+bool LoadShedder::update(const LoadSample& sample) {
+    if (!enabled || levels.size() < 2) {
+        return false;
+    }
+
+    bool lagging = sample.loopMs > sample.tickMs || sample.budgetMisses > 0 ||
+                   sample.receiverFill >= receiverFillThreshold;
+    bool healthy = !lagging && sample.loopMs <= sample.tickMs * recoveryHeadroom;
+
+    laggingLoops = lagging ? laggingLoops + 1 : 0;
+    healthyLoops = healthy ? healthyLoops + 1 : 0;
+
+    if (laggingLoops >= overloadLoops && stage + 1 < levels.size()) {
+        ++stage;
+        laggingLoops = 0;
+        shedDecisions->add();
+        stageGauge->set(static_cast<int64_t>(stage));
+        spdlog::warn("[LoadShedder] Falling behind ({}), shedding work below priority {}",
+                     describeLag(sample), levels[stage]);
+        return true;
+    }
+
+    if (healthyLoops >= recoveryLoops && stage > 0) {
+        --stage;
+        healthyLoops = 0;
+        recoverDecisions->add();
+        stageGauge->set(static_cast<int64_t>(stage));
+        if (stage == 0) {
+            spdlog::info("[LoadShedder] Load has dropped, no longer shedding work");
+        } else {
+            spdlog::info("[LoadShedder] Load has dropped, now shedding work below priority {}", levels[stage]);
+        }
+        return true;
+    }
+    return false;
+}
+
+bool LoadShedder::isShed(int priority) const {
+    return priority < getThreshold();
+}
+
+int LoadShedder::getThreshold() const {
+    return stage > 0 ? levels[stage] : INT_MIN;
+}
+
+int LoadShedder::getChannelDecimation() const {
+    return channelDecimation;
+}
+
+std::string LoadShedder::describeLag(const LoadSample& sample) const {
+    std::string reasons;
+    auto append = [&reasons](const std::string& reason) {
+        reasons += (reasons.empty() ? "" : ", ") + reason;
+    };
+    if (sample.loopMs > sample.tickMs) {
+        append(fmt::format("loop took {:.1f}ms of a {:.0f}ms tick", sample.loopMs, sample.tickMs));
+    }
+    if (sample.budgetMisses > 0) {
+        append(fmt::format("{} latency budget miss(es)", sample.budgetMisses));
+    }
+    if (sample.receiverFill >= receiverFillThreshold) {
+        append(fmt::format("event queue {:.0f}% full", sample.receiverFill * 100));
+    }
+    return reasons;
+}
@@ -0,0 +1,33 @@
+#include "data_transmitter/PayloadInspector.h"
+#include "utilities/Hash.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <string_view>
+
+PayloadInspector::PayloadInspector(uint64_t sampleEvery, size_t previewBytes, std::shared_ptr<StreamRecorder> tee)
+    : sampleEvery(std::max<uint64_t>(sampleEvery, 1)), previewBytes(previewBytes), tee(std::move(tee)),
+      inspectedCount(0) {}
+
+bool PayloadInspector::inspect(const std::string& address, const std::string& channel,
+                               const std::shared_ptr<const std::string>& payload) {
+    uint64_t index = messagesSeen[channel]++;
+    if (index % sampleEvery != 0) {
+        return false;
+    }
+    ++inspectedCount;
+
+    std::string_view data(*payload);
+    std::string_view preview = data.substr(0, previewBytes);
+    spdlog::info("[PayloadInspector] {} on {} message #{}: {} bytes, xxh64 {:016x}: {}{}",
+                 channel, address, index, data.size(), xxHash64(data), preview,
+                 preview.size() < data.size() ? "... <truncated>" : "");
+
+    if (tee) {
+        tee->record(address, channel, payload);
+    }
+    return true;
+}
+
+uint64_t PayloadInspector::getInspectedCount() const {
+    return inspectedCount;
+}
@@ -0,0 +1,160 @@
+#include "data_transmitter/StreamRecorder.h"
+#include <spdlog/spdlog.h>
+#include <filesystem>
+#include <ctime>
+
+using namespace stream_recording;
+
+const size_t SEGMENT_WRITE_BUFFER_SIZE = 4 * 1024 * 1024;
+const std::chrono::seconds SEGMENT_FLUSH_INTERVAL(1);
+
+StreamRecorder::StreamRecorder(const std::string& directory, size_t segmentSizeBytes, size_t maxQueuedBytes, int verbose)
+    : directory_(directory), segmentSizeBytes_(segmentSizeBytes), maxQueuedBytes_(maxQueuedBytes), verbose_(verbose),
+      queuedBytes_(0), stopping_(false), segment_(nullptr), segmentBuffer_(SEGMENT_WRITE_BUFFER_SIZE),
+      segmentBytes_(0), segmentIndex_(0), recordedCount_(0), droppedCount_(0) {
+    std::time_t now = std::time(nullptr);
+    char name[32];
+    std::strftime(name, sizeof(name), "%Y%m%d-%H%M%S", std::localtime(&now));
+    sessionName_ = name;
+
+    writer_ = std::thread(&StreamRecorder::writerLoop, this);
+}
+
+StreamRecorder::~StreamRecorder() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wakeup_.notify_one();
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+    spdlog::info("StreamRecorder: recorded {} message(s), dropped {}", recordedCount_.load(), droppedCount_.load());
+}
+
+void StreamRecorder::record(const std::string& address, const std::string& topic, std::shared_ptr<const std::string> payload) {
+    uint64_t timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queuedBytes_ + payload->size() > maxQueuedBytes_) {
+            droppedCount_++;
+            return;
+        }
+        queuedBytes_ += payload->size();
+        queue_.push_back({timestampNs, address, topic, std::move(payload)});
+    }
+    wakeup_.notify_one();
+}
+
+uint64_t StreamRecorder::getRecordedCount() const {
+    return recordedCount_.load();
+}
+
+uint64_t StreamRecorder::getDroppedCount() const {
+    return droppedCount_.load();
+}
+
+void StreamRecorder::writerLoop() {
+    std::vector<Record> batch;
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true) {
+        wakeup_.wait_for(lock, SEGMENT_FLUSH_INTERVAL, [this] { return stopping_ || !queue_.empty(); });
+        if (queue_.empty() && stopping_) {
+            break;
+        }
+
+        batch.swap(queue_);
+        queuedBytes_ = 0;
+        lock.unlock();
+
+        for (const auto& record : batch) {
+            if (writeRecord(record)) {
+                recordedCount_++;
+            } else {
+                droppedCount_++;
+            }
+        }
+        batch.clear();
+
+        // Let stdio coalesce writes, but do not keep data in memory for long
+        auto now = std::chrono::steady_clock::now();
+        if (segment_ && now - lastFlush_ >= SEGMENT_FLUSH_INTERVAL) {
+            std::fflush(segment_);
+            lastFlush_ = now;
+        }
+
+        lock.lock();
+    }
+
+    closeSegment();
+}
+
+bool StreamRecorder::writeRecord(const Record& record) {
+    if (segment_ && segmentBytes_ >= segmentSizeBytes_) {
+        closeSegment();
+    }
+    if (!segment_ && !openSegment()) {
+        return false;
+    }
+
+    RecordHeader header{};
+    header.magic = RECORD_MAGIC;
+    header.addressSize = static_cast<uint32_t>(record.address.size());
+    header.topicSize = static_cast<uint32_t>(record.topic.size());
+    header.timestampNs = record.timestampNs;
+    header.payloadSize = record.payload->size();
+
+    bool ok = std::fwrite(&header, sizeof(header), 1, segment_) == 1
+        && std::fwrite(record.address.data(), 1, record.address.size(), segment_) == record.address.size()
+        && std::fwrite(record.topic.data(), 1, record.topic.size(), segment_) == record.topic.size()
+        && std::fwrite(record.payload->data(), 1, record.payload->size(), segment_) == record.payload->size();
+
+    if (!ok) {
+        spdlog::error("StreamRecorder: write to segment {} failed, starting a new one", segmentIndex_);
+        closeSegment();
+        return false;
+    }
+
+    segmentBytes_ += sizeof(header) + record.address.size() + record.topic.size() + record.payload->size();
+    return true;
+}
+
+bool StreamRecorder::openSegment() {
+    std::error_code ec;
+    std::filesystem::create_directories(directory_, ec);
+
+    char index[16];
+    std::snprintf(index, sizeof(index), "%05u", segmentIndex_++);
+    std::filesystem::path path = std::filesystem::path(directory_) / (sessionName_ + "_" + index + SEGMENT_EXTENSION);
+
+    segment_ = std::fopen(path.c_str(), "wb");
+    if (!segment_) {
+        spdlog::error("StreamRecorder: failed to open segment {}", path.string());
+        return false;
+    }
+    std::setvbuf(segment_, segmentBuffer_.data(), _IOFBF, segmentBuffer_.size());
+
+    if (std::fwrite(FILE_MAGIC, sizeof(FILE_MAGIC), 1, segment_) != 1) {
+        spdlog::error("StreamRecorder: failed to write header to {}", path.string());
+        closeSegment();
+        return false;
+    }
+    segmentBytes_ = sizeof(FILE_MAGIC);
+    lastFlush_ = std::chrono::steady_clock::now();
+
+    if (verbose_ > 0) {
+        spdlog::debug("StreamRecorder: recording to {}", path.string());
+    }
+    return true;
+}
+
+void StreamRecorder::closeSegment() {
+    if (segment_) {
+        std::fclose(segment_);
+        segment_ = nullptr;
+    }
+    segmentBytes_ = 0;
+}
@@ -0,0 +1,155 @@
+#include "data_transmitter/StreamReplayer.h"
+#include "data_transmitter/StreamRecorder.h"
+#include "data_transmitter/DataTransmitterManager.h"
+#include "utilities/SignalHandler.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <thread>
+
+using namespace stream_recording;
+
+namespace {
+int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}
+
+StreamReplayer::StreamReplayer(const std::string& path, double speed, int verbose)
+    : path_(path), speed_(speed), verbose_(verbose), replayedCount_(0), replayedBytes_(0) {}
+
+bool StreamReplayer::run() {
+    std::vector<std::string> segments = listSegments();
+    if (segments.empty()) {
+        spdlog::error("StreamReplayer: no recording segments found at {}", path_);
+        return false;
+    }
+
+    spdlog::info("StreamReplayer: replaying {} segment(s) from {} at {}", segments.size(), path_,
+                 speed_ > 0 ? std::to_string(speed_) + "x" : std::string("maximum speed"));
+
+    uint64_t firstTimestampNs = 0;
+    int64_t startTime = steadyNowNs();
+    bool success = true;
+
+    for (const auto& segment : segments) {
+        if (SignalHandler::getInstance().isQuitSignalReceived()) {
+            break;
+        }
+        if (!replaySegment(segment, firstTimestampNs, startTime)) {
+            success = false;
+            break;
+        }
+    }
+
+    double elapsedSeconds = (steadyNowNs() - startTime) / 1e9;
+    if (elapsedSeconds > 0) {
+        spdlog::info("StreamReplayer: replayed {} message(s), {} bytes in {:.3f} s ({:.1f} msg/s, {:.2f} MB/s)",
+                     replayedCount_, replayedBytes_, elapsedSeconds,
+                     replayedCount_ / elapsedSeconds, replayedBytes_ / elapsedSeconds / 1e6);
+    }
+    return success;
+}
+
+uint64_t StreamReplayer::getReplayedCount() const {
+    return replayedCount_;
+}
+
+std::vector<std::string> StreamReplayer::listSegments() const {
+    std::vector<std::string> segments;
+    std::error_code ec;
+
+    if (std::filesystem::is_regular_file(path_, ec)) {
+        segments.push_back(path_);
+        return segments;
+    }
+
+    for (const auto& entry : std::filesystem::directory_iterator(path_, ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == SEGMENT_EXTENSION) {
+            segments.push_back(entry.path().string());
+        }
+    }
+    // Segment names are "<session time>_<index>", so lexical order is recording order
+    std::sort(segments.begin(), segments.end());
+    return segments;
+}
+
+bool StreamReplayer::replaySegment(const std::string& segmentPath, uint64_t& firstTimestampNs, int64_t startTime) {
+    std::unique_ptr<std::FILE, decltype(&std::fclose)> file(std::fopen(segmentPath.c_str(), "rb"), &std::fclose);
+    std::error_code ec;
+    uint64_t segmentSize = std::filesystem::file_size(segmentPath, ec);
+    if (!file || ec) {
+        spdlog::error("StreamReplayer: failed to open {}", segmentPath);
+        return false;
+    }
+
+    std::vector<char> readBuffer(4 * 1024 * 1024);
+    std::setvbuf(file.get(), readBuffer.data(), _IOFBF, readBuffer.size());
+
+    char magic[sizeof(FILE_MAGIC)];
+    if (std::fread(magic, sizeof(magic), 1, file.get()) != 1 || std::memcmp(magic, FILE_MAGIC, sizeof(magic)) != 0) {
+        spdlog::error("StreamReplayer: {} is not a recording segment", segmentPath);
+        return false;
+    }
+
+    DataTransmitterManager& transmitterManager = DataTransmitterManager::Instance();
+    RecordHeader header;
+    std::string address;
+    std::string topic;
+    uint64_t offset = sizeof(magic);
+
+    while (std::fread(&header, sizeof(header), 1, file.get()) == 1) {
+        if (SignalHandler::getInstance().isQuitSignalReceived()) {
+            return true;
+        }
+        offset += sizeof(header);
+        // Bound the sizes by what is left of the segment before allocating anything for them
+        uint64_t remaining = segmentSize > offset ? segmentSize - offset : 0;
+        if (header.magic != RECORD_MAGIC || header.payloadSize > remaining
+            || uint64_t(header.addressSize) + header.topicSize > remaining - header.payloadSize) {
+            spdlog::error("StreamReplayer: corrupt record in {} after {} message(s)", segmentPath, replayedCount_);
+            return false;
+        }
+        offset += uint64_t(header.addressSize) + header.topicSize + header.payloadSize;
+
+        address.resize(header.addressSize);
+        topic.resize(header.topicSize);
+        auto payload = std::make_shared<std::string>(header.payloadSize, '\0');
+        if (std::fread(address.data(), 1, address.size(), file.get()) != address.size()
+            || std::fread(topic.data(), 1, topic.size(), file.get()) != topic.size()
+            || std::fread(payload->data(), 1, payload->size(), file.get()) != payload->size()) {
+            spdlog::error("StreamReplayer: truncated record in {}", segmentPath);
+            return false;
+        }
+
+        if (replayedCount_ == 0 && firstTimestampNs == 0) {
+            firstTimestampNs = header.timestampNs;
+        }
+
+        // Hold each record back until its original offset from the first one
+        if (speed_ > 0 && header.timestampNs > firstTimestampNs) {
+            int64_t targetNs = startTime + static_cast<int64_t>((header.timestampNs - firstTimestampNs) / speed_);
+            int64_t waitNs = targetNs - steadyNowNs();
+            if (waitNs > 0) {
+                std::this_thread::sleep_for(std::chrono::nanoseconds(waitNs));
+            }
+        }
+
+        auto transmitter = transmitterManager.getTransmitter(address);
+        if (!transmitter->publish(topic, std::move(payload))) {
+            return false;
+        }
+
+        replayedCount_++;
+        replayedBytes_ += header.payloadSize;
+        if (verbose_ > 1) {
+            spdlog::debug("StreamReplayer: replayed {} bytes to {} on {}", header.payloadSize, topic, address);
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,44 @@
+#include "data_transmitter/TokenBucket.h"
+#include <algorithm>
+
+TokenBucket::TokenBucket()
+    : ratePerSecond(0), burst(0), tokens(0), lastRefill(Clock::now()) {
+}
+
+TokenBucket::TokenBucket(double ratePerSecond, double burst)
+    : ratePerSecond(std::max(ratePerSecond, 0.0)), burst(std::max(burst, 1.0)), tokens(0), lastRefill(Clock::now()) {
+    tokens = this->burst;
+}
+
+bool TokenBucket::isLimited() const {
+    return ratePerSecond > 0;
+}
+
+bool TokenBucket::hasTokens(double amount, Clock::time_point now) {
+    if (!isLimited()) {
+        return true;
+    }
+    refill(now);
+    return amount > 0 ? tokens >= amount : tokens > 0;
+}
+
+void TokenBucket::consume(double amount, Clock::time_point now) {
+    if (!isLimited()) {
+        return;
+    }
+    refill(now);
+    tokens -= amount;
+}
+
+double TokenBucket::getTokens() const {
+    return tokens;
+}
+
+void TokenBucket::refill(Clock::time_point now) {
+    if (now <= lastRefill) {
+        return;
+    }
+    double seconds = std::chrono::duration<double>(now - lastRefill).count();
+    tokens = std::min(burst, tokens + seconds * ratePerSecond);
+    lastRefill = now;
+}
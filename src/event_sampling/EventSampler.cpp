@@ -0,0 +1,60 @@
+#include "event_sampling/EventSampler.h"
+#include "event_sampling/EveryNthSampler.h"
+#include "event_sampling/RandomSampler.h"
+#include "event_sampling/LatestOnlySampler.h"
+#include "event_sampling/ReservoirSampler.h"
+#include "event_sampling/MinIntervalSampler.h"
+#include <random>
+#include <stdexcept>
+
+const size_t DEFAULT_LATEST_ONLY_SCAN_LIMIT = 10000;
+const int DEFAULT_RESERVOIR_WINDOW_MS = 1000;
+const size_t DEFAULT_RESERVOIR_SIZE = 10;
+
+std::unique_ptr<EventSampler> EventSampler::create(const nlohmann::json& config) {
+    std::string type = config.value("type", "all");
+    uint64_t seed = config.value("seed", uint64_t(std::random_device{}()));
+
+    if (type == "all") {
+        return nullptr;
+    }
+
+    if (type == "every-nth") {
+        uint64_t n = config.value("n", uint64_t(1));
+        if (n == 0) {
+            throw std::invalid_argument("[EventSampler] every-nth sampling requires 'n' of at least 1.");
+        }
+        return std::make_unique<EveryNthSampler>(n);
+    }
+
+    if (type == "random") {
+        double fraction = config.value("fraction", 1.0);
+        if (fraction < 0.0 || fraction > 1.0) {
+            throw std::invalid_argument("[EventSampler] random sampling requires a 'fraction' between 0 and 1.");
+        }
+        return std::make_unique<RandomSampler>(fraction, seed);
+    }
+
+    if (type == "latest-only") {
+        return std::make_unique<LatestOnlySampler>(config.value("scan-limit", DEFAULT_LATEST_ONLY_SCAN_LIMIT));
+    }
+
+    if (type == "reservoir") {
+        int windowMs = config.value("window-ms", DEFAULT_RESERVOIR_WINDOW_MS);
+        size_t size = config.value("size", DEFAULT_RESERVOIR_SIZE);
+        if (windowMs <= 0 || size == 0) {
+            throw std::invalid_argument("[EventSampler] reservoir sampling requires a positive 'window-ms' and 'size'.");
+        }
+        return std::make_unique<ReservoirSampler>(std::chrono::milliseconds(windowMs), size, seed);
+    }
+
+    if (type == "min-interval") {
+        int intervalMs = config.value("interval-ms", 0);
+        if (intervalMs <= 0) {
+            throw std::invalid_argument("[EventSampler] min-interval sampling requires a positive 'interval-ms'.");
+        }
+        return std::make_unique<MinIntervalSampler>(std::chrono::milliseconds(intervalMs));
+    }
+
+    throw std::invalid_argument("[EventSampler] Unknown sampling type '" + type + "'.");
+}
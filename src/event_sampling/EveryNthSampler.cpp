@@ -0,0 +1,18 @@
+#include "event_sampling/EveryNthSampler.h"
+
+EveryNthSampler::EveryNthSampler(uint64_t n)
+    : n_(n) {}
+
+TimedEventList EveryNthSampler::select(TimedEventList events) {
+    TimedEventList kept;
+    for (auto& event : events) {
+        if (seen_++ % n_ == 0) {
+            kept.push_back(std::move(event));
+        }
+    }
+    return kept;
+}
+
+std::string EveryNthSampler::getName() const {
+    return "one event in " + std::to_string(n_);
+}
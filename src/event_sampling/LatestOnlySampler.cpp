@@ -0,0 +1,21 @@
+#include "event_sampling/LatestOnlySampler.h"
+#include <algorithm>
+
+LatestOnlySampler::LatestOnlySampler(size_t scanLimit)
+    : scanLimit_(std::max<size_t>(scanLimit, 1)) {}
+
+TimedEventList LatestOnlySampler::select(TimedEventList events) {
+    TimedEventList kept;
+    if (!events.empty()) {
+        kept.push_back(std::move(events.back()));
+    }
+    return kept;
+}
+
+size_t LatestOnlySampler::getRetrievalLimit(size_t configured) const {
+    return std::max(configured, scanLimit_);
+}
+
+std::string LatestOnlySampler::getName() const {
+    return "latest event only";
+}
@@ -0,0 +1,22 @@
+#include "event_sampling/MinIntervalSampler.h"
+
+MinIntervalSampler::MinIntervalSampler(std::chrono::milliseconds interval)
+    : interval_(interval) {}
+
+TimedEventList MinIntervalSampler::select(TimedEventList events) {
+    TimedEventList kept;
+    for (auto& event : events) {
+        int eventId = eventOf(*event).event_id;
+        auto it = lastKept_.find(eventId);
+        if (it != lastKept_.end() && event->timestamp - it->second < interval_) {
+            continue;
+        }
+        lastKept_[eventId] = event->timestamp;
+        kept.push_back(std::move(event));
+    }
+    return kept;
+}
+
+std::string MinIntervalSampler::getName() const {
+    return "one event per ID every " + std::to_string(interval_.count()) + "ms";
+}
@@ -0,0 +1,18 @@
+#include "event_sampling/RandomSampler.h"
+
+RandomSampler::RandomSampler(double fraction, uint64_t seed)
+    : fraction_(fraction), random_(seed), keep_(fraction) {}
+
+TimedEventList RandomSampler::select(TimedEventList events) {
+    TimedEventList kept;
+    for (auto& event : events) {
+        if (keep_(random_)) {
+            kept.push_back(std::move(event));
+        }
+    }
+    return kept;
+}
+
+std::string RandomSampler::getName() const {
+    return "random fraction " + std::to_string(fraction_);
+}
@@ -0,0 +1,43 @@
+#include "event_sampling/ReservoirSampler.h"
+#include <algorithm>
+
+ReservoirSampler::ReservoirSampler(std::chrono::milliseconds window, size_t size, uint64_t seed)
+    : window_(window), size_(size), random_(seed), windowStart_(std::chrono::steady_clock::now()) {
+    reservoir_.reserve(size_);
+}
+
+TimedEventList ReservoirSampler::select(TimedEventList events) {
+    for (auto& event : events) {
+        uint64_t index = seenInWindow_++;
+        if (reservoir_.size() < size_) {
+            reservoir_.emplace_back(index, std::move(event));
+            continue;
+        }
+        // Replace a kept event with probability size / seen
+        uint64_t slot = std::uniform_int_distribution<uint64_t>(0, index)(random_);
+        if (slot < size_) {
+            reservoir_[slot] = {index, std::move(event)};
+        }
+    }
+
+    TimedEventList released;
+    auto now = std::chrono::steady_clock::now();
+    if (now - windowStart_ < window_) {
+        return released;
+    }
+
+    std::sort(reservoir_.begin(), reservoir_.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    released.reserve(reservoir_.size());
+    for (auto& [index, event] : reservoir_) {
+        released.push_back(std::move(event));
+    }
+    reservoir_.clear();
+    seenInWindow_ = 0;
+    windowStart_ = now;
+    return released;
+}
+
+std::string ReservoirSampler::getName() const {
+    return std::to_string(size_) + " events per " + std::to_string(window_.count()) + "ms reservoir";
+}
@@ -0,0 +1,138 @@
+#include "event_sources/EventHeaderFilter.h"
+#include <algorithm>
+#include <cstring>
+
+// Layout of a MIDAS event: a 16-byte event header, then the bank header (size and flags), then the banks
+const size_t EVENT_HEADER_BYTES = 16;
+const size_t BANK_HEADER_BYTES = 8;
+const uint32_t BANK_FORMAT_32BIT = 1 << 4;
+const uint32_t BANK_FORMAT_64BIT_ALIGNED = 1 << 5;
+
+EventHeaderFilterConfig EventHeaderFilterConfig::fromJson(const nlohmann::json& config) {
+    EventHeaderFilterConfig result;
+    if (config.contains("event-ids") && config["event-ids"].is_array()) {
+        result.eventIds = config["event-ids"].get<std::vector<uint16_t>>();
+    } else if (config.contains("event-id")) {
+        result.eventIds.push_back(config["event-id"].get<uint16_t>());
+    }
+    result.triggerMask = config.value("trigger-mask", result.triggerMask);
+    result.minSerial = config.value("min-serial", result.minSerial);
+    result.maxSerial = config.value("max-serial", result.maxSerial);
+    result.minSizeBytes = config.value("min-size-bytes", result.minSizeBytes);
+    result.maxSizeBytes = config.value("max-size-bytes", result.maxSizeBytes);
+    if (config.contains("banks") && config["banks"].is_array()) {
+        result.requiredBanks = config["banks"].get<std::vector<std::string>>();
+    }
+    return result;
+}
+
+EventHeaderFilter::EventHeaderFilter(const EventHeaderFilterConfig& config)
+    : config_(config) {}
+
+bool EventHeaderFilter::accepts(const TMEvent& event) const {
+    if (!config_.eventIds.empty() &&
+        std::find(config_.eventIds.begin(), config_.eventIds.end(), event.event_id) == config_.eventIds.end()) {
+        return false;
+    }
+    if (config_.triggerMask != 0 && (event.trigger_mask & config_.triggerMask) == 0) {
+        return false;
+    }
+    if (event.serial_number < config_.minSerial || event.serial_number > config_.maxSerial) {
+        return false;
+    }
+    if (event.data_size < config_.minSizeBytes || event.data_size > config_.maxSizeBytes) {
+        return false;
+    }
+    if (config_.requiredBanks.empty()) {
+        return true;
+    }
+
+    for (const auto& bank : config_.requiredBanks) {
+        if (!hasBank(event, bank)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool EventHeaderFilter::hasBank(const TMEvent& event, const std::string& name) {
+    // Events are shared between consumers, so walk the raw bank headers instead of
+    // indexing them with TMEvent::FindAllBanks()
+    if (name.size() != 4 || event.data.size() < EVENT_HEADER_BYTES + BANK_HEADER_BYTES) {
+        return false;
+    }
+    const char* bankArea = event.data.data() + EVENT_HEADER_BYTES;
+    uint32_t banksBytes;
+    uint32_t flags;
+    std::memcpy(&banksBytes, bankArea, sizeof(banksBytes));
+    std::memcpy(&flags, bankArea + 4, sizeof(flags));
+
+    bool wide = flags & (BANK_FORMAT_32BIT | BANK_FORMAT_64BIT_ALIGNED);
+    size_t bankHeaderBytes = (flags & BANK_FORMAT_64BIT_ALIGNED) ? 16 : wide ? 12 : 8;
+    size_t end = std::min<size_t>(BANK_HEADER_BYTES + banksBytes, event.data.size() - EVENT_HEADER_BYTES);
+    size_t position = BANK_HEADER_BYTES;
+    while (position + bankHeaderBytes <= end) {
+        const char* bank = bankArea + position;
+        if (std::memcmp(bank, name.data(), 4) == 0) {
+            return true;
+        }
+        size_t dataBytes;
+        if (wide) {
+            uint32_t size;
+            std::memcpy(&size, bank + 8, sizeof(size));
+            dataBytes = size;
+        } else {
+            uint16_t size;
+            std::memcpy(&size, bank + 6, sizeof(size));
+            dataBytes = size;
+        }
+        // Bank data is padded to 8 bytes
+        position += bankHeaderBytes + ((dataBytes + 7) & ~size_t(7));
+    }
+    return false;
+}
+
+TimedEventList EventHeaderFilter::apply(TimedEventList events) const {
+    events.erase(std::remove_if(events.begin(), events.end(),
+                                [this](const TimedEventPtr& event) { return !accepts(eventOf(*event)); }),
+                 events.end());
+    return events;
+}
+
+bool EventHeaderFilter::isActive() const {
+    return !config_.eventIds.empty() || config_.triggerMask != 0 ||
+           config_.minSerial > 0 || config_.maxSerial < std::numeric_limits<uint32_t>::max() ||
+           config_.minSizeBytes > 0 || config_.maxSizeBytes < std::numeric_limits<uint32_t>::max() ||
+           !config_.requiredBanks.empty();
+}
+
+std::string EventHeaderFilter::describe() const {
+    std::string criteria;
+    auto append = [&criteria](const std::string& criterion) {
+        criteria += (criteria.empty() ? "" : ", ") + criterion;
+    };
+    if (!config_.eventIds.empty()) {
+        std::string ids;
+        for (uint16_t id : config_.eventIds) {
+            ids += (ids.empty() ? "" : "/") + std::to_string(id);
+        }
+        append("event ID " + ids);
+    }
+    if (config_.triggerMask != 0) {
+        append("trigger mask " + std::to_string(config_.triggerMask));
+    }
+    if (config_.minSerial > 0 || config_.maxSerial < std::numeric_limits<uint32_t>::max()) {
+        append("serial " + std::to_string(config_.minSerial) + "-" + std::to_string(config_.maxSerial));
+    }
+    if (config_.minSizeBytes > 0 || config_.maxSizeBytes < std::numeric_limits<uint32_t>::max()) {
+        append("size " + std::to_string(config_.minSizeBytes) + "-" + std::to_string(config_.maxSizeBytes) + " bytes");
+    }
+    if (!config_.requiredBanks.empty()) {
+        std::string banks;
+        for (const auto& bank : config_.requiredBanks) {
+            banks += (banks.empty() ? "" : "/") + bank;
+        }
+        append("banks " + banks);
+    }
+    return criteria.empty() ? "all events" : criteria;
+}
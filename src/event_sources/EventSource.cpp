@@ -0,0 +1,27 @@
+#include "event_sources/EventSource.h"
+#include "event_sources/MidasFileEventSource.h"
+#include "event_sources/SyntheticEventSource.h"
+#include <stdexcept>
+
+std::unique_ptr<EventSource> EventSource::createOffline(const nlohmann::json& config) {
+    std::string sourceType = config.value("type", "synthetic");
+
+    if (sourceType == "file") {
+        std::vector<std::string> files;
+        if (config.contains("files") && config["files"].is_array()) {
+            files = config["files"].get<std::vector<std::string>>();
+        } else if (config.contains("file")) {
+            files.push_back(config["file"].get<std::string>());
+        }
+        if (files.empty()) {
+            throw std::invalid_argument("[EventSource] File event source requires 'file' or 'files'.");
+        }
+        return std::make_unique<MidasFileEventSource>(files, config.value("speed", 0.0), config.value("loop", false));
+    }
+
+    if (sourceType == "synthetic") {
+        return std::make_unique<SyntheticEventSource>(SyntheticEventConfig::fromJson(config));
+    }
+
+    throw std::invalid_argument("[EventSource] Unknown event source type '" + sourceType + "'.");
+}
@@ -0,0 +1,45 @@
+#include "event_sources/LagPolicy.h"
+#include <stdexcept>
+
+LagPolicy LagPolicy::fromJson(const nlohmann::json& config) {
+    LagPolicy result;
+    std::string mode = config.value("mode", "all");
+    if (mode == "latest") {
+        result.mode = LagMode::Latest;
+    } else if (mode == "all") {
+        result.mode = LagMode::All;
+    } else if (mode == "bounded") {
+        result.mode = LagMode::Bounded;
+    } else {
+        throw std::invalid_argument("[LagPolicy] Unknown lag-policy mode '" + mode + "'.");
+    }
+
+    result.maxLagEvents = config.value("max-lag-events", result.maxLagEvents);
+    result.maxLagMs = std::chrono::milliseconds(config.value("max-lag-ms", int64_t(0)));
+    result.catchUpBatch = config.value("catch-up-batch", result.catchUpBatch);
+    if (result.mode == LagMode::Bounded && result.maxLagEvents == 0 && result.maxLagMs.count() <= 0) {
+        throw std::invalid_argument("[LagPolicy] bounded lag-policy requires 'max-lag-events' or 'max-lag-ms'.");
+    }
+    return result;
+}
+
+std::string LagPolicy::describe() const {
+    switch (mode) {
+    case LagMode::Latest:
+        return "latest (skip any backlog)";
+    case LagMode::Bounded: {
+        std::string limits;
+        if (maxLagEvents > 0) {
+            limits += std::to_string(maxLagEvents) + " events";
+        }
+        if (maxLagMs.count() > 0) {
+            limits += (limits.empty() ? "" : " or ") + std::to_string(maxLagMs.count()) + " ms";
+        }
+        return "bounded (skip beyond " + limits + ")";
+    }
+    case LagMode::All:
+    default:
+        return catchUpBatch > 0 ? "all (catch up " + std::to_string(catchUpBatch) + " events at a time)"
+                                : "all";
+    }
+}
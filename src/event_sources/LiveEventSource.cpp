@@ -0,0 +1,37 @@
+#include "event_sources/LiveEventSource.h"
+#include <algorithm>
+#include <limits>
+
+LiveEventSource::LiveEventSource(std::shared_ptr<EventConsumer> consumer, const LagPolicy& lagPolicy,
+                                 std::shared_ptr<const EventHeaderFilter> filter)
+    : consumer_(std::move(consumer)), lagPolicy_(lagPolicy), filter_(std::move(filter)) {}
+
+TimedEventList LiveEventSource::getLatestEvents(size_t maxEvents) {
+    const EventHeaderFilter* filter = filter_.get();
+    switch (lagPolicy_.mode) {
+    case LagMode::Latest:
+        // Whatever is older than this call's batch would only be shown stale
+        consumer_->skip(maxEvents, std::chrono::system_clock::time_point::min(), filter);
+        return consumer_->take(maxEvents, filter);
+    case LagMode::Bounded: {
+        size_t keep = lagPolicy_.maxLagEvents > 0 ? lagPolicy_.maxLagEvents : std::numeric_limits<size_t>::max();
+        auto notBefore = lagPolicy_.maxLagMs.count() > 0
+                             ? std::chrono::system_clock::now() - lagPolicy_.maxLagMs
+                             : std::chrono::system_clock::time_point::min();
+        consumer_->skip(keep, notBefore, filter);
+        return consumer_->take(maxEvents, filter);
+    }
+    case LagMode::All:
+    default:
+        // A larger limit only matters while behind; when caught up, fewer events are waiting anyway
+        return consumer_->take(std::max(maxEvents, lagPolicy_.catchUpBatch), filter);
+    }
+}
+
+uint64_t LiveEventSource::getFilteredCount() const {
+    return consumer_->getFilteredCount();
+}
+
+std::string LiveEventSource::getName() const {
+    return "MIDAS receiver (" + consumer_->getName() + ")";
+}
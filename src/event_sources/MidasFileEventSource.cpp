@@ -0,0 +1,122 @@
+#include "event_sources/MidasFileEventSource.h"
+#include <spdlog/spdlog.h>
+
+// MIDAS reserves these event IDs for begin/end-of-run ODB dumps and messages
+const uint16_t EVENTID_BEGIN_OF_RUN = 0x8000;
+const uint16_t EVENTID_END_OF_RUN   = 0x8001;
+
+MidasFileEventSource::MidasFileEventSource(const std::vector<std::string>& files, double speed, bool loop)
+    : files_(files), fileIndex_(0), reader_(nullptr), speed_(speed), loop_(loop), exhausted_(files.empty()),
+      runNumber_(-1), haveFirstEvent_(false), firstEventTime_(0) {}
+
+MidasFileEventSource::~MidasFileEventSource() {
+    closeReader();
+}
+
+TimedEventList MidasFileEventSource::getLatestEvents(size_t maxEvents) {
+    TimedEventList events;
+    auto now = std::chrono::system_clock::now();
+    auto steadyNow = std::chrono::steady_clock::now();
+
+    while (events.size() < maxEvents) {
+        if (!pending_) {
+            pending_ = readNext();
+            if (!pending_) {
+                break;
+            }
+        }
+
+        // Each pass of a looping replay starts over, as does a file older than the first one
+        if (!haveFirstEvent_ || pending_->time_stamp < firstEventTime_) {
+            haveFirstEvent_ = true;
+            firstEventTime_ = pending_->time_stamp;
+            replayStart_ = steadyNow;
+        }
+
+        // Hold the event back until its original offset from the first one has elapsed
+        if (speed_ > 0 && pending_->time_stamp > firstEventTime_) {
+            auto offset = std::chrono::duration<double>((pending_->time_stamp - firstEventTime_) / speed_);
+            if (steadyNow - replayStart_ < offset) {
+                break;
+            }
+        }
+
+        events.push_back(makeTimedEvent(std::move(*pending_), now));
+        pending_.reset();
+    }
+
+    return events;
+}
+
+bool MidasFileEventSource::isExhausted() const {
+    return exhausted_ && !pending_;
+}
+
+INT MidasFileEventSource::getRunNumber() const {
+    return runNumber_;
+}
+
+std::string MidasFileEventSource::getName() const {
+    return "MIDAS file replay (" + std::to_string(files_.size()) + " file(s))";
+}
+
+std::unique_ptr<TMEvent> MidasFileEventSource::readNext() {
+    while (!exhausted_) {
+        if (!reader_ && !openNextFile()) {
+            return nullptr;
+        }
+
+        std::unique_ptr<TMEvent> event(TMReadEvent(reader_));
+        if (!event || event->error) {
+            closeReader();
+            continue;
+        }
+
+        if (event->event_id == EVENTID_BEGIN_OF_RUN || event->event_id == EVENTID_END_OF_RUN) {
+            // For run transition events the serial number holds the run number
+            runNumber_ = static_cast<INT>(event->serial_number);
+            continue;
+        }
+        if (event->event_id & 0x8000) {
+            continue;
+        }
+
+        return event;
+    }
+    return nullptr;
+}
+
+bool MidasFileEventSource::openNextFile() {
+    // Give up once every file has failed in a row, so a bad list cannot spin forever
+    for (size_t attempts = 0; attempts < files_.size(); ++attempts) {
+        if (fileIndex_ >= files_.size()) {
+            if (!loop_) {
+                break;
+            }
+            fileIndex_ = 0;
+            // Pace the next pass from its own first event
+            haveFirstEvent_ = false;
+        }
+
+        const std::string& file = files_[fileIndex_++];
+        reader_ = TMNewReader(file.c_str());
+        if (reader_ && !reader_->fError) {
+            spdlog::info("[MidasFileEventSource] Reading events from {}", file);
+            return true;
+        }
+
+        spdlog::error("[MidasFileEventSource] Failed to open {}", file);
+        closeReader();
+    }
+
+    exhausted_ = true;
+    return false;
+}
+
+void MidasFileEventSource::closeReader() {
+    if (reader_) {
+        reader_->Close();
+        delete reader_;
+        reader_ = nullptr;
+    }
+}
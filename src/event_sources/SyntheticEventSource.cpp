@@ -0,0 +1,96 @@
+#include "event_sources/SyntheticEventSource.h"
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+
+SyntheticEventConfig SyntheticEventConfig::fromJson(const nlohmann::json& config) {
+    SyntheticEventConfig result;
+    result.rateHz = config.value("rate-hz", result.rateHz);
+    result.eventId = config.value("event-id", result.eventId);
+    result.triggerMask = config.value("trigger-mask", result.triggerMask);
+    result.numBanks = config.value("num-banks", result.numBanks);
+    result.bankSizeBytes = config.value("bank-size-bytes", result.bankSizeBytes);
+    result.runNumber = config.value("run-number", result.runNumber);
+    result.maxEvents = config.value("max-events", result.maxEvents);
+    result.maxBacklog = config.value("max-backlog", result.maxBacklog);
+    result.seed = config.value("seed", result.seed);
+    return result;
+}
+
+SyntheticEventSource::SyntheticEventSource(const SyntheticEventConfig& config)
+    : config_(config), generated_(0), dropped_(0), rngState_(config.seed ? config.seed : 1),
+      bankData_((config.bankSizeBytes + sizeof(uint32_t) - 1) / sizeof(uint32_t)),
+      start_(std::chrono::steady_clock::now()) {}
+
+TimedEventList SyntheticEventSource::getLatestEvents(size_t maxEvents) {
+    TimedEventList events;
+
+    uint64_t available = maxEvents;
+    if (config_.rateHz > 0) {
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+        uint64_t due = static_cast<uint64_t>(elapsed * config_.rateHz);
+        uint64_t backlog = due > generated_ ? due - generated_ : 0;
+
+        // Like a receiver buffer, only the newest maxBacklog events survive
+        if (backlog > config_.maxBacklog) {
+            uint64_t lost = backlog - config_.maxBacklog;
+            dropped_ += lost;
+            generated_ += lost;
+            backlog = config_.maxBacklog;
+        }
+        available = std::min<uint64_t>(available, backlog);
+    }
+    if (config_.maxEvents > 0) {
+        available = std::min<uint64_t>(available, config_.maxEvents - std::min(generated_, config_.maxEvents));
+    }
+
+    auto now = std::chrono::system_clock::now();
+    events.reserve(available);
+    for (uint64_t i = 0; i < available; ++i) {
+        events.push_back(makeTimedEvent(generateEvent(), now));
+    }
+    return events;
+}
+
+bool SyntheticEventSource::isExhausted() const {
+    return config_.maxEvents > 0 && generated_ >= config_.maxEvents;
+}
+
+INT SyntheticEventSource::getRunNumber() const {
+    return config_.runNumber;
+}
+
+std::string SyntheticEventSource::getName() const {
+    return "synthetic events (" + std::to_string(config_.numBanks) + " x " +
+           std::to_string(bankData_.size() * sizeof(uint32_t)) + " byte banks)";
+}
+
+uint64_t SyntheticEventSource::getDroppedCount() const {
+    return dropped_;
+}
+
+TMEvent SyntheticEventSource::generateEvent() {
+    size_t bankBytes = bankData_.size() * sizeof(uint32_t);
+
+    TMEvent event;
+    event.Init(config_.eventId, config_.triggerMask, static_cast<uint32_t>(generated_),
+               static_cast<uint32_t>(std::time(nullptr)),
+               config_.numBanks * (bankBytes + 16) + 16);
+
+    for (size_t bank = 0; bank < config_.numBanks; ++bank) {
+        for (auto& word : bankData_) {
+            // xorshift64: cheap enough not to dominate what we are measuring
+            rngState_ ^= rngState_ << 13;
+            rngState_ ^= rngState_ >> 7;
+            rngState_ ^= rngState_ << 17;
+            word = static_cast<uint32_t>(rngState_);
+        }
+
+        char name[8];
+        std::snprintf(name, sizeof(name), "S%03zu", bank % 1000);
+        event.AddBank(name, TID_DWORD, reinterpret_cast<const char*>(bankData_.data()), bankBytes);
+    }
+
+    ++generated_;
+    return event;
+}
@@ -18,21 +18,39 @@
 #include "utilities/SignalHandler.h"
 #include "processors/GeneralProcessorFactory.h"
 #include "utilities/LoggerConfig.h"
+#include "data_transmitter/StreamRecorder.h"
+#include "data_transmitter/PayloadInspector.h"
+#include "data_transmitter/StreamReplayer.h"
+#include "receivers/MidasReceiverProvider.h"
+#include "metrics/MetricsRegistry.h"
+#include "metrics/MetricsExporter.h"
+#include "metrics/EventTracer.h"
 
 // Project Headers for processors
 #include "processors/GeneralProcessor.h"
 #include "processors/CommandProcessor.h"
+#include "processors/StreamingCommandProcessor.h"
+#include "processors/FileWatchProcessor.h"
 #include "processors/MidasEventProcessor.h"
 #include "processors/MidasOdbProcessor.h"
+#include "processors/StatsProcessor.h"
 
 // Logging
 #include <spdlog/spdlog.h>
 
 // Standard Libraries
 #include <nlohmann/json.hpp>
+#include <algorithm>
 #include <fstream>
 #include <chrono>
 #include <thread>
+#include <memory>
+#include <string>
+#include <ctime>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
 
 using json = nlohmann::json;
 
@@ -57,6 +75,14 @@ void registerProcessors(nlohmann::json config) {
         return new CommandProcessor(verbose);
     });
 
+    factory.RegisterProcessor("StreamingCommandProcessor", [verbose]() -> GeneralProcessor* {
+        return new StreamingCommandProcessor(verbose);
+    });
+
+    factory.RegisterProcessor("FileWatchProcessor", [verbose]() -> GeneralProcessor* {
+        return new FileWatchProcessor(verbose);
+    });
+
     factory.RegisterProcessor("MidasEventProcessor", [verbose]() -> GeneralProcessor* {
         return new MidasEventProcessor(verbose);
     });
@@ -64,11 +90,156 @@ void registerProcessors(nlohmann::json config) {
     factory.RegisterProcessor("MidasOdbProcessor", [verbose]() -> GeneralProcessor* {
         return new MidasOdbProcessor(verbose);
     });
+
+    factory.RegisterProcessor("StatsProcessor", [verbose]() -> GeneralProcessor* {
+        return new StatsProcessor(verbose);
+    });
+}
+
+/**
+ * @brief Creates the stream recorder described by general-settings, if enabled.
+ *
+ * @param generalSettings The "general-settings" section of the configuration.
+ * @param verbose Verbosity level for logging.
+ * @return The recorder, or nullptr if recording is disabled.
+ */
+std::shared_ptr<StreamRecorder> createRecorder(const nlohmann::json& generalSettings, int verbose) {
+    if (!generalSettings.contains("recording") || !generalSettings["recording"].value("enabled", false)) {
+        return nullptr;
+    }
+
+    const nlohmann::json& recordingConfig = generalSettings["recording"];
+    std::string directory = recordingConfig.value("directory", "recordings");
+    size_t segmentSizeMb = recordingConfig.value("segment-size-mb", 256);
+    size_t maxQueuedMb = recordingConfig.value("max-queued-mb", 256);
+
+    spdlog::info("Recording published messages to {}", directory);
+    return std::make_shared<StreamRecorder>(directory, segmentSizeMb * 1024 * 1024, maxQueuedMb * 1024 * 1024, verbose);
+}
+
+/**
+ * @brief Creates the payload inspector described by general-settings, if enabled.
+ *
+ * Inspection is also switched on by verbosity above 1, which used to log every payload.
+ *
+ * @param generalSettings The "general-settings" section of the configuration.
+ * @param verbose Verbosity level for logging.
+ * @return The inspector, or nullptr if inspection is disabled.
+ */
+std::shared_ptr<PayloadInspector> createPayloadInspector(const nlohmann::json& generalSettings, int verbose) {
+    nlohmann::json inspectionConfig = generalSettings.value("payload-inspection", nlohmann::json::object());
+    if (!inspectionConfig.value("enabled", false) && verbose <= 1) {
+        return nullptr;
+    }
+
+    uint64_t sampleEvery = inspectionConfig.value("sample-every", 100);
+    size_t previewBytes = inspectionConfig.value("preview-bytes", 1000);
+
+    std::shared_ptr<StreamRecorder> tee;
+    nlohmann::json teeConfig = inspectionConfig.value("tee", nlohmann::json::object());
+    if (teeConfig.value("enabled", false)) {
+        std::string directory = teeConfig.value("directory", "payload-samples");
+        size_t segmentSizeMb = teeConfig.value("segment-size-mb", 64);
+        size_t maxQueuedMb = teeConfig.value("max-queued-mb", 64);
+        tee = std::make_shared<StreamRecorder>(directory, segmentSizeMb * 1024 * 1024, maxQueuedMb * 1024 * 1024, verbose);
+        spdlog::info("Writing sampled payloads to {}", directory);
+    }
+
+    spdlog::info("Inspecting 1 in {} published messages per channel", sampleEvery);
+    return std::make_shared<PayloadInspector>(sampleEvery, previewBytes, tee);
+}
+
+/**
+ * @brief Creates the metrics exporter described by general-settings, if enabled.
+ *
+ * @param generalSettings The "general-settings" section of the configuration.
+ * @return The exporter, or nullptr if metrics export is disabled.
+ */
+std::unique_ptr<MetricsExporter> createMetricsExporter(const nlohmann::json& generalSettings) {
+    if (!generalSettings.contains("metrics") || !generalSettings["metrics"].value("enabled", false)) {
+        return nullptr;
+    }
+
+    const nlohmann::json& metricsConfig = generalSettings["metrics"];
+    std::string jsonFile = metricsConfig.value("json-file", "metrics/metrics.json");
+    std::string prometheusFile = metricsConfig.value("prometheus-file", "metrics/publisher.prom");
+    int intervalMs = metricsConfig.value("interval-ms", 5000);
+
+    spdlog::info("Exporting metrics every {} ms to {} and {}", intervalMs, jsonFile, prometheusFile);
+    return std::make_unique<MetricsExporter>(jsonFile, prometheusFile, std::chrono::milliseconds(intervalMs));
+}
+
+/**
+ * @brief Enables event tracing as described by general-settings, if enabled.
+ *
+ * @param generalSettings The "general-settings" section of the configuration.
+ * @return The directory traces are dumped to, or an empty string if tracing is disabled.
+ */
+std::string configureTracing(const nlohmann::json& generalSettings) {
+    if (!generalSettings.contains("tracing") || !generalSettings["tracing"].value("enabled", false)) {
+        return "";
+    }
+
+    const nlohmann::json& tracingConfig = generalSettings["tracing"];
+    EventTracer::Instance().enable(tracingConfig.value("sample-every", 1000),
+                                   tracingConfig.value("capacity", 65536));
+    return tracingConfig.value("directory", "traces");
+}
+
+/**
+ * @brief Dumps the traced events to a timestamped Chrome trace file.
+ *
+ * @param directory The directory to write to.
+ */
+void dumpTrace(const std::string& directory) {
+    std::time_t now = std::time(nullptr);
+    char stamp[32];
+    std::strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", std::localtime(&now));
+    EventTracer::Instance().dump(directory + "/publisher-trace-" + stamp + ".json");
+}
+
+/**
+ * @brief Prints the command-line usage to stderr.
+ *
+ * @param program The name the program was started with.
+ */
+void printUsage(const char* program) {
+    std::fprintf(stderr,
+                 "Usage: %s [--config <file>] [--replay <recording> [--replay-speed <x>]]\n"
+                 "  --config <file>       configuration file (default: config/config.json)\n"
+                 "  --replay <recording>  re-publish a recording instead of running the data channels\n"
+                 "  --replay-speed <x>    timing scale for --replay, 0 for as fast as possible (default: 1)\n",
+                 program);
+}
+
+/**
+ * @brief Parses a --replay-speed value.
+ *
+ * @param text The value given on the command line.
+ * @param speed Set to the speed if the value is valid.
+ * @return True if the value is a finite, non-negative number.
+ */
+bool parseReplaySpeed(const char* text, double& speed) {
+    char* end = nullptr;
+    errno = 0;
+    double value = std::strtod(text, &end);
+    if (end == text || *end != '\0' || errno == ERANGE || !std::isfinite(value) || value < 0) {
+        return false;
+    }
+    speed = value;
+    return true;
 }
 
 /**
  * @brief The main function of the program.
  *
+ * `--config <file>` uses another configuration file than config/config.json.
+ * Passing `--replay <recording>` re-publishes a recording made with general-settings.recording
+ * instead of running the data channels. `--replay-speed <x>` scales the original timing;
+ * 0 replays as fast as possible (default is 1).
+ *
+ * With general-settings.tracing enabled, SIGUSR1 dumps the traced events without stopping.
+ *
  * @param argc Number of command-line arguments.
  * @param argv Array of command-line arguments.
  * @return Exit code.
@@ -76,9 +247,32 @@ void registerProcessors(nlohmann::json config) {
 int main(int argc, char* argv[]) {
     utils::LoggerConfig::ConfigureFromFile();
 
+    // Parse command-line options
+    std::string configPath;
+    std::string replayPath;
+    double replaySpeed = 1.0;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--config" && i + 1 < argc) {
+            configPath = argv[++i];
+        } else if (arg == "--replay" && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (arg == "--replay-speed" && i + 1 < argc) {
+            const char* speed = argv[++i];
+            if (!parseReplaySpeed(speed, replaySpeed)) {
+                spdlog::error("Invalid --replay-speed '{}': expected a non-negative number", speed);
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else {
+            spdlog::warn("Ignoring unknown argument '{}'", arg);
+        }
+    }
+
     // Get cleaned up config
-    JsonManager::getInstance();
-    nlohmann::json config = JsonManager::getInstance().getConfig();
+    nlohmann::json config = configPath.empty()
+        ? JsonManager::getInstance().getConfig()
+        : JsonManager::getInstance(configPath).getConfig();
 
     // Get verbosity level
     int verbose = config["general-settings"]["verbose"].get<int>();
@@ -93,6 +287,33 @@ int main(int argc, char* argv[]) {
     // Initialize the DataTransmitterManager
     DataTransmitterManager::Instance(verbose);
 
+    // Replay mode: re-publish a recording instead of running the data channels
+    if (!replayPath.empty()) {
+        StreamReplayer replayer(replayPath, replaySpeed, verbose);
+        bool success = replayer.run();
+        spdlog::info("Exiting main program.");
+        utils::LoggerConfig::Shutdown();
+        return success ? 0 : 1;
+    }
+
+    // Optionally record everything we publish
+    DataTransmitterManager::Instance().setRecorder(createRecorder(config["general-settings"], verbose));
+
+    // Optionally log a sample of what we publish
+    DataTransmitterManager::Instance().setPayloadInspector(createPayloadInspector(config["general-settings"], verbose));
+
+    // Pick the real MIDAS receiver or the in-process stand-in before any processor binds to it
+    MidasReceiverProvider::Instance().configure(
+        config["general-settings"].value("midas-receiver", nlohmann::json::object()));
+    MidasReceiverInterface& midasReceiver = MidasReceiverProvider::Instance().get();
+
+    // Optionally export metrics
+    std::unique_ptr<MetricsExporter> metricsExporter = createMetricsExporter(config["general-settings"]);
+    LoopMetrics& loopMetrics = MetricsRegistry::Instance().loop();
+
+    // Optionally trace sampled events through every stage
+    std::string traceDirectory = configureTracing(config["general-settings"]);
+
     // Register processors
     registerProcessors(config);
 
@@ -103,31 +324,57 @@ int main(int argc, char* argv[]) {
     dataChannelManager.setGlobalTickTime();
     int tickTime = dataChannelManager.getGlobalTickTime();
 
+    // Optionally shed low-priority work when falling behind
+    dataChannelManager.configureLoadShedding(config["general-settings"].value("load-shedding", nlohmann::json::object()));
+
+    // Optionally bound the memory held by all channel buffers together
+    double bufferBudgetMb = config["general-settings"].value("buffer-budget-mb", 0.0);
+    dataChannelManager.setBufferByteBudget(static_cast<size_t>(std::max(bufferBudgetMb, 0.0) * 1024 * 1024));
+
     // Variables for timing statistics
     size_t loopCount = 0;
     std::chrono::microseconds totalDuration(0);
 
     // Main loop
     while (!SignalHandler::getInstance().isQuitSignalReceived() && 
-           (MidasReceiver::getInstance().isListeningForEvents() || !MidasReceiver::getInstance().IsRunning())) {
+           (midasReceiver.isListeningForEvents() || !midasReceiver.isRunning())) {
 
         auto start = std::chrono::high_resolution_clock::now();
         dataChannelManager.publish();
         auto end = std::chrono::high_resolution_clock::now();
 
         totalDuration += std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        loopMetrics.duration->record(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        if (end - start > std::chrono::milliseconds(tickTime)) {
+            loopMetrics.deadlineMisses->add();
+        }
         ++loopCount;
 
         if (verbose > 0) {
             spdlog::debug("Finished loop, sleeping for {}ms ...", tickTime);
         }
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(tickTime));
+        if (SignalHandler::getInstance().consumeDumpRequest() && !traceDirectory.empty()) {
+            dumpTrace(traceDirectory);
+        }
+
+        // Sleep until the next tick, answering late subscribers in the meantime
+        DataTransmitterManager::Instance().waitForSubscriptions(tickTime);
     }
 
     // Clean up and exit
     spdlog::info("Received quit signal or MidasReceiver is not running. Stopping MidasReceiver...");
-    MidasReceiver::getInstance().stop();
+    midasReceiver.stop();
+
+    // Drain and close the recordings before static teardown
+    DataTransmitterManager::Instance().setRecorder(nullptr);
+    DataTransmitterManager::Instance().setPayloadInspector(nullptr);
+
+    // Write the final metrics and trace
+    metricsExporter.reset();
+    if (!traceDirectory.empty()) {
+        dumpTrace(traceDirectory);
+    }
 
     // Print timing summary
     if (loopCount > 0) {
@@ -137,5 +384,6 @@ int main(int argc, char* argv[]) {
 
 
     spdlog::info("Exiting main program.");
+    utils::LoggerConfig::Shutdown();
     return 0;
 }
@@ -0,0 +1,132 @@
+#include "metrics/EventTracer.h"
+#include "utilities/JsonWriter.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+thread_local std::vector<uint64_t> EventTracer::openTraces_;
+
+EventTracer& EventTracer::Instance() {
+    static EventTracer instance;
+    return instance;
+}
+
+void EventTracer::enable(uint64_t sampleEvery, size_t capacity) {
+    if (enabled_.load()) {
+        return;
+    }
+
+    size_t size = 1;
+    while (size < std::max<size_t>(capacity, 2)) {
+        size <<= 1;
+    }
+    slots_ = std::make_unique<Slot[]>(size);
+    mask_ = size - 1;
+    sampleEvery_ = std::max<uint64_t>(sampleEvery, 1);
+    enabled_.store(true);
+
+    spdlog::info("[EventTracer] Tracing 1 in {} events into {} spans", sampleEvery_, size);
+}
+
+uint64_t EventTracer::sampleEvent() {
+    if (!enabled_.load(std::memory_order_relaxed)) {
+        return 0;
+    }
+    if (eventsSeen_.fetch_add(1, std::memory_order_relaxed) % sampleEvery_ != 0) {
+        return 0;
+    }
+
+    uint64_t traceId = nextTraceId_.fetch_add(1, std::memory_order_relaxed);
+    openTraces_.push_back(traceId);
+    return traceId;
+}
+
+void EventTracer::record(uint64_t traceId, const char* stage, int64_t startNs, int64_t endNs) {
+    if (traceId == 0 || !enabled_.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    uint64_t ticket = head_.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots_[ticket & mask_];
+
+    // Seqlock: odd while writing, so a concurrent dump skips the slot
+    slot.sequence.store(2 * ticket + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.traceId.store(traceId, std::memory_order_relaxed);
+    slot.stage.store(stage, std::memory_order_relaxed);
+    slot.startNs.store(startNs, std::memory_order_relaxed);
+    slot.durationNs.store(endNs - startNs, std::memory_order_relaxed);
+    slot.sequence.store(2 * ticket + 2, std::memory_order_release);
+}
+
+void EventTracer::recordOpen(const char* stage, int64_t startNs, int64_t endNs) {
+    for (uint64_t traceId : openTraces_) {
+        record(traceId, stage, startNs, endNs);
+    }
+}
+
+bool EventTracer::hasOpenTraces() const {
+    return !openTraces_.empty();
+}
+
+void EventTracer::closeOpenTraces() {
+    openTraces_.clear();
+}
+
+long EventTracer::dump(const std::string& path) const {
+    if (!enabled_.load()) {
+        return 0;
+    }
+
+    JsonWriter writer;
+    writer.beginObject().key("displayTimeUnit").value("ns").key("traceEvents").beginArray();
+
+    long written = 0;
+    uint64_t head = head_.load(std::memory_order_acquire);
+    uint64_t first = head > mask_ + 1 ? head - (mask_ + 1) : 0;
+    for (uint64_t ticket = first; ticket < head; ++ticket) {
+        const Slot& slot = slots_[ticket & mask_];
+
+        uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != 2 * ticket + 2) {
+            continue; // Still being written, or already overwritten
+        }
+        uint64_t traceId = slot.traceId.load(std::memory_order_relaxed);
+        const char* stage = slot.stage.load(std::memory_order_relaxed);
+        int64_t startNs = slot.startNs.load(std::memory_order_relaxed);
+        int64_t durationNs = slot.durationNs.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+            continue;
+        }
+
+        // Complete ("X") events in microseconds; one track per traced event
+        writer.beginObject()
+            .key("name").value(stage)
+            .key("cat").value("publisher")
+            .key("ph").value("X")
+            .key("ts").value(startNs / 1000.0)
+            .key("dur").value(durationNs / 1000.0)
+            .key("pid").value(1)
+            .key("tid").value(traceId)
+            .key("args").beginObject().key("trace_id").value(traceId).endObject()
+            .endObject();
+        ++written;
+    }
+    writer.endArray().endObject();
+
+    std::filesystem::path target(path);
+    std::error_code error;
+    if (target.has_parent_path()) {
+        std::filesystem::create_directories(target.parent_path(), error);
+    }
+    std::ofstream stream(path, std::ios::trunc);
+    if (!stream || !(stream << writer.str())) {
+        spdlog::error("[EventTracer] Failed to write trace to {}", path);
+        return -1;
+    }
+
+    spdlog::info("[EventTracer] Wrote {} spans to {}", written, path);
+    return written;
+}
@@ -0,0 +1,106 @@
+#include "metrics/Metrics.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+const uint64_t SUB_BUCKETS = uint64_t(1) << Histogram::SUB_BUCKET_BITS;
+const uint64_t LARGEST_RESOLVED = (uint64_t(1) << (Histogram::MAX_EXPONENT + 1)) - 1;
+}
+
+void Histogram::record(uint64_t value) {
+    buckets_[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t previous = max_.load(std::memory_order_relaxed);
+    while (value > previous && !max_.compare_exchange_weak(previous, value, std::memory_order_relaxed)) {
+    }
+}
+
+uint64_t Histogram::getCount() const {
+    return count_.load(std::memory_order_relaxed);
+}
+
+uint64_t Histogram::getSum() const {
+    return sum_.load(std::memory_order_relaxed);
+}
+
+uint64_t Histogram::getMax() const {
+    return max_.load(std::memory_order_relaxed);
+}
+
+uint64_t Histogram::getQuantile(double quantile) const {
+    return std::min(snapshot().quantile(quantile), getMax());
+}
+
+HistogramSnapshot Histogram::snapshot() const {
+    HistogramSnapshot result;
+    result.counts.resize(NUM_BUCKETS);
+    for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+        result.counts[i] = buckets_[i].load(std::memory_order_relaxed);
+        result.count += result.counts[i];
+    }
+    result.sum = sum_.load(std::memory_order_relaxed);
+    return result;
+}
+
+HistogramSnapshot HistogramSnapshot::since(const HistogramSnapshot& earlier) const {
+    HistogramSnapshot result = *this;
+    if (earlier.counts.size() != counts.size()) {
+        return result;
+    }
+    result.count = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        result.counts[i] = counts[i] >= earlier.counts[i] ? counts[i] - earlier.counts[i] : 0;
+        result.count += result.counts[i];
+    }
+    result.sum = sum >= earlier.sum ? sum - earlier.sum : 0;
+    return result;
+}
+
+uint64_t HistogramSnapshot::quantile(double quantile) const {
+    if (count == 0) {
+        return 0;
+    }
+
+    quantile = std::clamp(quantile, 0.0, 1.0);
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(quantile * count)));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return Histogram::bucketUpperBound(i);
+        }
+    }
+    return max();
+}
+
+uint64_t HistogramSnapshot::max() const {
+    for (size_t i = counts.size(); i > 0; --i) {
+        if (counts[i - 1] > 0) {
+            return Histogram::bucketUpperBound(i - 1);
+        }
+    }
+    return 0;
+}
+
+size_t Histogram::bucketIndex(uint64_t value) {
+    value = std::min(value, LARGEST_RESOLVED);
+    if (value < 2 * SUB_BUCKETS) {
+        return static_cast<size_t>(value);
+    }
+
+    // Keep the top SUB_BUCKET_BITS + 1 bits; the leading one selects the power of two
+    unsigned msb = 63 - __builtin_clzll(value);
+    unsigned shift = msb - SUB_BUCKET_BITS;
+    return static_cast<size_t>(shift * SUB_BUCKETS + (value >> shift));
+}
+
+uint64_t Histogram::bucketUpperBound(size_t index) {
+    if (index < 2 * SUB_BUCKETS) {
+        return index;
+    }
+    unsigned shift = static_cast<unsigned>(index / SUB_BUCKETS) - 1;
+    uint64_t top = index % SUB_BUCKETS + SUB_BUCKETS;
+    return ((top + 1) << shift) - 1;
+}
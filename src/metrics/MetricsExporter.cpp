@@ -0,0 +1,79 @@
+#include "metrics/MetricsExporter.h"
+#include "metrics/MetricsRegistry.h"
+#include <spdlog/spdlog.h>
+#include <filesystem>
+#include <fstream>
+
+MetricsExporter::MetricsExporter(const std::string& jsonFile, const std::string& prometheusFile,
+                                 std::chrono::milliseconds interval)
+    : jsonFile_(jsonFile), prometheusFile_(prometheusFile), interval_(interval), stopping_(false) {
+    thread_ = std::thread(&MetricsExporter::run, this);
+}
+
+MetricsExporter::~MetricsExporter() {
+    stop();
+}
+
+void MetricsExporter::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            return;
+        }
+        stopping_ = true;
+    }
+    wakeUp_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    exportNow();
+}
+
+bool MetricsExporter::exportNow() {
+    bool success = true;
+    if (!jsonFile_.empty()) {
+        success &= writeAtomically(jsonFile_, MetricsRegistry::Instance().toJson().dump(2) + "\n");
+    }
+    if (!prometheusFile_.empty()) {
+        success &= writeAtomically(prometheusFile_, MetricsRegistry::Instance().toPrometheus());
+    }
+    return success;
+}
+
+void MetricsExporter::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        if (wakeUp_.wait_for(lock, interval_, [this] { return stopping_; })) {
+            break;
+        }
+        lock.unlock();
+        exportNow();
+        lock.lock();
+    }
+}
+
+bool MetricsExporter::writeAtomically(const std::string& path, const std::string& contents) {
+    std::filesystem::path target(path);
+    std::filesystem::path temporary = target;
+    temporary += ".tmp";
+
+    std::error_code error;
+    if (target.has_parent_path()) {
+        std::filesystem::create_directories(target.parent_path(), error);
+    }
+
+    {
+        std::ofstream stream(temporary, std::ios::trunc);
+        if (!stream || !(stream << contents)) {
+            spdlog::warn("[MetricsExporter] Failed to write {}", temporary.string());
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temporary, target, error);
+    if (error) {
+        spdlog::warn("[MetricsExporter] Failed to move {} into place: {}", target.string(), error.message());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,278 @@
+#include "metrics/MetricsRegistry.h"
+#include <sstream>
+#include <stdexcept>
+
+using json = nlohmann::json;
+
+namespace {
+
+const double EXPORTED_QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+const double NANOSECONDS = 1e-9;
+
+std::string escapeLabelValue(const std::string& value) {
+    std::string escaped;
+    for (char c : value) {
+        if (c == '\\' || c == '"') {
+            escaped += '\\';
+            escaped += c;
+        } else if (c == '\n') {
+            escaped += "\\n";
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+std::string renderLabels(const MetricLabels& labels, const std::string& extraName = "", const std::string& extraValue = "") {
+    if (labels.empty() && extraName.empty()) {
+        return "";
+    }
+    std::string text = "{";
+    bool first = true;
+    for (const auto& [name, value] : labels) {
+        text += (first ? "" : ",") + name + "=\"" + escapeLabelValue(value) + "\"";
+        first = false;
+    }
+    if (!extraName.empty()) {
+        text += (first ? "" : ",") + extraName + "=\"" + extraValue + "\"";
+    }
+    return text + "}";
+}
+
+template <typename Metric>
+Metric& getOrCreate(std::map<MetricLabels, std::unique_ptr<Metric>>& series, const MetricLabels& labels) {
+    auto& metric = series[labels];
+    if (!metric) {
+        metric = std::make_unique<Metric>();
+    }
+    return *metric;
+}
+
+} // namespace
+
+MetricsRegistry& MetricsRegistry::Instance() {
+    static MetricsRegistry instance;
+    return instance;
+}
+
+MetricsRegistry::Family& MetricsRegistry::family(const std::string& name, const std::string& help, Type type) {
+    auto [it, inserted] = families_.try_emplace(name);
+    if (inserted) {
+        it->second.type = type;
+        it->second.help = help;
+    } else if (it->second.type != type) {
+        throw std::invalid_argument("[MetricsRegistry] Metric '" + name + "' is already registered with another type");
+    }
+    return it->second;
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help, const MetricLabels& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return getOrCreate(family(name, help, Type::Counter).counters, labels);
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name, const std::string& help, const MetricLabels& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return getOrCreate(family(name, help, Type::Gauge).gauges, labels);
+}
+
+Histogram& MetricsRegistry::histogram(const std::string& name, const std::string& help, const MetricLabels& labels,
+                                      double exportScale) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Family& histogramFamily = family(name, help, Type::Histogram);
+    histogramFamily.exportScale = exportScale;
+    return getOrCreate(histogramFamily.histograms, labels);
+}
+
+ChannelMetrics& MetricsRegistry::channel(const std::string& channel) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = channels_.find(channel);
+        if (it != channels_.end()) {
+            return *it->second;
+        }
+    }
+
+    MetricLabels labels = {{"channel", channel}};
+    auto metrics = std::make_unique<ChannelMetrics>(ChannelMetrics{
+        channel,
+        &counter("publisher_channel_messages_published_total", "Messages handed to zmq", labels),
+        &counter("publisher_channel_bytes_published_total", "Payload bytes handed to zmq", labels),
+        &counter("publisher_channel_messages_skipped_total", "Publishes skipped while the channel was on a break", labels),
+        &counter("publisher_channel_messages_rate_limited_total", "Publishes skipped by the channel's rate control", labels),
+        &counter("publisher_channel_send_errors_total", "Publishes that failed in zmq", labels),
+        &counter("publisher_channel_entries_overwritten_total", "Buffered entries overwritten before being published", labels),
+        &gauge("publisher_channel_buffer_depth", "Entries in the channel's circular buffer", labels),
+        &histogram("publisher_channel_serialization_seconds", "Time to serialize the channel buffer", labels, NANOSECONDS),
+        &histogram("publisher_channel_send_seconds", "Time to hand a message to zmq", labels, NANOSECONDS),
+        &counter("publisher_channel_publishes_shed_total", "Loops the channel sat out to shed load", labels),
+        &counter("publisher_channel_latency_budget_misses_total", "Publishes that took longer than the channel's latency budget", labels),
+        &gauge("publisher_channel_buffer_bytes", "Payload bytes in the channel's circular buffer", labels),
+        &gauge("publisher_channel_buffer_peak_bytes", "Most payload bytes ever held in the channel's circular buffer", labels),
+        &counter("publisher_channel_entries_evicted_total", "Buffered entries evicted to stay within the byte budget", labels)
+    });
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& slot = channels_[channel];
+    if (!slot) {
+        slot = std::move(metrics);
+    }
+    return *slot;
+}
+
+ProcessorMetrics& MetricsRegistry::processor(const std::string& channel, const std::string& processor, size_t index) {
+    std::string key = channel + "/" + std::to_string(index) + "/" + processor;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = processors_.find(key);
+        if (it != processors_.end()) {
+            return *it->second;
+        }
+    }
+
+    MetricLabels labels = {{"channel", channel}, {"processor", processor}, {"index", std::to_string(index)}};
+    auto metrics = std::make_unique<ProcessorMetrics>(ProcessorMetrics{
+        channel,
+        processor,
+        index,
+        &counter("publisher_processor_runs_total", "Calls to getProcessedOutput", labels),
+        &counter("publisher_processor_outputs_total", "Entries produced", labels),
+        &counter("publisher_processor_output_bytes_total", "Bytes produced", labels),
+        &histogram("publisher_processor_processing_seconds", "Time spent in getProcessedOutput", labels, NANOSECONDS),
+        &counter("publisher_processor_deadline_misses_total", "Runs that took longer than the processor's latency budget", labels),
+        &counter("publisher_processor_runs_shed_total", "Due runs skipped to shed load", labels),
+        &counter("publisher_processor_outputs_suppressed_total", "Entries left out for being unchanged", labels)
+    });
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& slot = processors_[key];
+    if (!slot) {
+        slot = std::move(metrics);
+    }
+    return *slot;
+}
+
+LoopMetrics& MetricsRegistry::loop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (loop_) {
+            return *loop_;
+        }
+    }
+
+    auto metrics = std::make_unique<LoopMetrics>(LoopMetrics{
+        &histogram("publisher_loop_seconds", "Time to publish all channels once", {}, NANOSECONDS),
+        &counter("publisher_loop_deadline_misses_total", "Loops that took longer than the tick time")
+    });
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!loop_) {
+        loop_ = std::move(metrics);
+    }
+    return *loop_;
+}
+
+std::vector<const ChannelMetrics*> MetricsRegistry::getChannels() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<const ChannelMetrics*> result;
+    for (const auto& [name, metrics] : channels_) {
+        result.push_back(metrics.get());
+    }
+    return result;
+}
+
+std::vector<const ProcessorMetrics*> MetricsRegistry::getProcessors() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<const ProcessorMetrics*> result;
+    for (const auto& [key, metrics] : processors_) {
+        result.push_back(metrics.get());
+    }
+    return result;
+}
+
+json MetricsRegistry::toJson() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    json result = json::object();
+
+    for (const auto& [name, metricFamily] : families_) {
+        json series = json::array();
+        std::string type;
+
+        switch (metricFamily.type) {
+        case Type::Counter:
+            type = "counter";
+            for (const auto& [labels, counter] : metricFamily.counters) {
+                series.push_back({{"labels", labels}, {"value", counter->get()}});
+            }
+            break;
+        case Type::Gauge:
+            type = "gauge";
+            for (const auto& [labels, gauge] : metricFamily.gauges) {
+                series.push_back({{"labels", labels}, {"value", gauge->get()}});
+            }
+            break;
+        case Type::Histogram:
+            type = "histogram";
+            for (const auto& [labels, histogram] : metricFamily.histograms) {
+                double scale = metricFamily.exportScale;
+                json quantiles = json::object();
+                for (double quantile : EXPORTED_QUANTILES) {
+                    std::ostringstream key;
+                    key << "p" << quantile * 100;
+                    quantiles[key.str()] = histogram->getQuantile(quantile) * scale;
+                }
+                series.push_back({
+                    {"labels", labels},
+                    {"count", histogram->getCount()},
+                    {"sum", histogram->getSum() * scale},
+                    {"max", histogram->getMax() * scale},
+                    {"quantiles", quantiles}
+                });
+            }
+            break;
+        }
+
+        result[name] = {{"type", type}, {"help", metricFamily.help}, {"series", series}};
+    }
+    return result;
+}
+
+std::string MetricsRegistry::toPrometheus() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ostringstream out;
+
+    for (const auto& [name, metricFamily] : families_) {
+        out << "# HELP " << name << " " << metricFamily.help << "\n";
+
+        switch (metricFamily.type) {
+        case Type::Counter:
+            out << "# TYPE " << name << " counter\n";
+            for (const auto& [labels, counter] : metricFamily.counters) {
+                out << name << renderLabels(labels) << " " << counter->get() << "\n";
+            }
+            break;
+        case Type::Gauge:
+            out << "# TYPE " << name << " gauge\n";
+            for (const auto& [labels, gauge] : metricFamily.gauges) {
+                out << name << renderLabels(labels) << " " << gauge->get() << "\n";
+            }
+            break;
+        case Type::Histogram:
+            out << "# TYPE " << name << " summary\n";
+            for (const auto& [labels, histogram] : metricFamily.histograms) {
+                double scale = metricFamily.exportScale;
+                for (double quantile : EXPORTED_QUANTILES) {
+                    std::ostringstream quantileText;
+                    quantileText << quantile;
+                    out << name << renderLabels(labels, "quantile", quantileText.str()) << " "
+                        << histogram->getQuantile(quantile) * scale << "\n";
+                }
+                out << name << "_sum" << renderLabels(labels) << " " << histogram->getSum() * scale << "\n";
+                out << name << "_count" << renderLabels(labels) << " " << histogram->getCount() << "\n";
+            }
+            break;
+        }
+    }
+    return out.str();
+}
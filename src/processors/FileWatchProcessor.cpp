@@ -0,0 +1,248 @@
+#include "processors/FileWatchProcessor.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Chunk read from a file at a time, straight into its record splitter
+const size_t FILE_READ_CHUNK_BYTES = 65536;
+const uint32_t DIRECTORY_EVENTS = IN_MODIFY | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO;
+
+FileWatchProcessor::FileWatchProcessor(int verbose)
+    : GeneralProcessor(verbose) {}
+
+FileWatchProcessor::~FileWatchProcessor() {
+    for (auto& file : files_) {
+        closeFile(file);
+    }
+    // Closing the inotify descriptor removes its watches
+    if (inotifyFd_ >= 0) {
+        close(inotifyFd_);
+    }
+}
+
+void FileWatchProcessor::Init(const nlohmann::json& config) {
+    std::vector<std::string> paths;
+    if (config.contains("files") && config["files"].is_array()) {
+        for (const auto& path : config["files"]) {
+            if (path.is_string() && !path.get<std::string>().empty()) {
+                paths.push_back(path.get<std::string>());
+            }
+        }
+    } else if (config.contains("file") && config["file"].is_string()) {
+        paths.push_back(config["file"].get<std::string>());
+    }
+    if (paths.empty()) {
+        throw std::invalid_argument("[FileWatchProcessor] 'files' is required.");
+    }
+
+    std::string delimiter = config.value("delimiter", std::string("\n"));
+    if (delimiter.empty()) {
+        throw std::invalid_argument("[FileWatchProcessor] 'delimiter' must not be empty.");
+    }
+    size_t maxRecordBytes = config.value("max-record-bytes", size_t(1048576));
+    fromStart_ = config.value("from-start", fromStart_);
+    maxReadBytes_ = std::max<size_t>(config.value("max-read-bytes", maxReadBytes_), FILE_READ_CHUNK_BYTES);
+
+    inotifyFd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd_ < 0) {
+        throw std::runtime_error(std::string("[FileWatchProcessor] inotify is not available: ") + std::strerror(errno));
+    }
+
+    // Directories rather than files are watched, so a file can be replaced or appear later
+    files_.reserve(paths.size());
+    for (const auto& path : paths) {
+        size_t slash = path.rfind('/');
+        std::string directory = slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+        int watch = inotify_add_watch(inotifyFd_, directory.c_str(), DIRECTORY_EVENTS);
+        if (watch < 0) {
+            spdlog::warn("[FileWatchProcessor] Cannot watch directory '{}' of '{}': {}",
+                         directory, path, std::strerror(errno));
+            continue;
+        }
+
+        WatchedFile file;
+        file.path = path;
+        file.name = slash == std::string::npos ? path : path.substr(slash + 1);
+        file.watch = watch;
+        file.records = RecordSplitter(delimiter, maxRecordBytes);
+        files_.push_back(std::move(file));
+
+        if (openFile(files_.back(), !fromStart_)) {
+            files_.back().changed = fromStart_;
+            backlog_ = backlog_ || fromStart_;
+            spdlog::info("[FileWatchProcessor] Following '{}' from byte {}", path, files_.back().offset);
+        } else {
+            spdlog::info("[FileWatchProcessor] Waiting for '{}' to be created", path);
+        }
+    }
+    if (files_.empty()) {
+        throw std::runtime_error("[FileWatchProcessor] None of the files can be watched.");
+    }
+}
+
+bool FileWatchProcessor::isReadyToProcess() const {
+    if (inotifyFd_ < 0) return false;
+    if (std::chrono::steady_clock::now() - lastProcessedTime_ < std::chrono::milliseconds(period)) {
+        return false;
+    }
+    if (backlog_) {
+        return true;
+    }
+    pollfd events = {inotifyFd_, POLLIN, 0};
+    return poll(&events, 1, 0) > 0;
+}
+
+std::vector<std::string> FileWatchProcessor::getProcessedOutput() {
+    std::vector<std::string> out;
+    lastProcessedTime_ = std::chrono::steady_clock::now();
+    if (!readEvents() && !backlog_) {
+        return out;
+    }
+
+    backlog_ = false;
+    for (auto& file : files_) {
+        if (file.changed) {
+            file.changed = false;
+            readFile(file, out);
+            backlog_ = backlog_ || file.changed;
+        }
+    }
+    return out;
+}
+
+bool FileWatchProcessor::readEvents() {
+    bool changed = false;
+    alignas(inotify_event) std::array<char, 65536> buffer;
+    while (true) {
+        ssize_t bytes = read(inotifyFd_, buffer.data(), buffer.size());
+        if (bytes < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytes <= 0) {
+            break;
+        }
+
+        for (char* next = buffer.data(); next < buffer.data() + bytes;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(next);
+            next += sizeof(inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                // Events were lost, so any file may have changed
+                spdlog::warn("[FileWatchProcessor] inotify queue overflowed, checking every file");
+                for (auto& file : files_) {
+                    file.changed = true;
+                }
+                changed = true;
+                continue;
+            }
+            if (event->len == 0) {
+                continue;
+            }
+            for (auto& file : files_) {
+                if (file.watch == event->wd && file.name == event->name) {
+                    file.changed = true;
+                    changed = true;
+                }
+            }
+        }
+    }
+    return changed;
+}
+
+void FileWatchProcessor::readFile(WatchedFile& file, std::vector<std::string>& out) {
+    if (file.fd >= 0) {
+        // Whatever was written before a rotation is read before following the new file
+        if (!readToEnd(file)) {
+            file.changed = true;
+            file.records.split(out);
+            return;
+        }
+
+        struct stat pathStat;
+        struct stat fileStat;
+        bool replaced = stat(file.path.c_str(), &pathStat) != 0 || pathStat.st_ino != file.inode ||
+                        pathStat.st_dev != file.device;
+        if (replaced) {
+            spdlog::info("[FileWatchProcessor] '{}' was replaced after {} bytes", file.path, file.offset);
+            file.records.flush(out);
+            closeFile(file);
+        } else if (fstat(file.fd, &fileStat) == 0 && fileStat.st_size < file.offset) {
+            spdlog::info("[FileWatchProcessor] '{}' was truncated, reading it from the start", file.path);
+            file.records.flush(out);
+            file.offset = 0;
+        }
+    }
+
+    if (file.fd < 0 && !openFile(file, false)) {
+        file.records.split(out);
+        return;
+    }
+    if (!readToEnd(file)) {
+        file.changed = true;
+    }
+    file.records.split(out);
+}
+
+bool FileWatchProcessor::readToEnd(WatchedFile& file) {
+    std::string& data = file.records.buffer();
+    size_t remaining = maxReadBytes_;
+    while (remaining > 0) {
+        size_t size = data.size();
+        size_t chunk = std::min(remaining, FILE_READ_CHUNK_BYTES);
+        data.resize(size + chunk);
+        ssize_t bytes = pread(file.fd, &data[size], chunk, file.offset);
+        data.resize(size + static_cast<size_t>(std::max<ssize_t>(bytes, 0)));
+
+        if (bytes < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytes < 0) {
+            spdlog::warn("[FileWatchProcessor] Failed to read '{}': {}", file.path, std::strerror(errno));
+            return true;
+        }
+        // A short read is the current end; anything appended later raises another event
+        file.offset += bytes;
+        remaining -= static_cast<size_t>(bytes);
+        if (static_cast<size_t>(bytes) < chunk) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FileWatchProcessor::openFile(WatchedFile& file, bool atEnd) {
+    int fd = open(file.path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        if (errno != ENOENT) {
+            spdlog::warn("[FileWatchProcessor] Failed to open '{}': {}", file.path, std::strerror(errno));
+        }
+        return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0) {
+        close(fd);
+        return false;
+    }
+    file.fd = fd;
+    file.device = fileStat.st_dev;
+    file.inode = fileStat.st_ino;
+    file.offset = atEnd ? fileStat.st_size : 0;
+    return true;
+}
+
+void FileWatchProcessor::closeFile(WatchedFile& file) {
+    if (file.fd >= 0) {
+        close(file.fd);
+        file.fd = -1;
+    }
+    file.offset = 0;
+}
@@ -5,24 +5,29 @@
 #include <chrono>
 #include <spdlog/spdlog.h>
 #include "analysis_pipeline/core/context/input_bundle.h"
+#include "event_sources/LiveEventSource.h"
+#include "receivers/MidasReceiverProvider.h"
+#include "utilities/SignalHandler.h"
+#include "metrics/EventTracer.h"
+#include <algorithm>
 
 using json = nlohmann::json;
 
+const std::chrono::seconds THROUGHPUT_REPORT_INTERVAL(5);
+
 MidasEventProcessor::MidasEventProcessor(int verbose)
     : GeneralProcessor(verbose),
-      midasReceiver_(MidasReceiver::getInstance()),
-      lastEventTimestamp_(std::chrono::system_clock::now()),
+      midasReceiver_(MidasReceiverProvider::Instance().get()),
       lastTransitionTimestamp_(std::chrono::system_clock::now()) {}
 
 MidasEventProcessor::~MidasEventProcessor() {
-    if (initialized_) {
-        midasReceiver_.stop();
-    }
+    // The receiver is shared by every live processor; main stops it once at shutdown
 }
 
 void MidasEventProcessor::Init(const json& midas_receiver_config,
                                const json& pipeline_config,
-                               const json& midas_event_processor_config)
+                               const json& midas_event_processor_config,
+                               const std::string& default_consumer_name)
 {
     if (!midas_receiver_config.is_object() || !pipeline_config.is_object() || !midas_event_processor_config.is_object()) {
         throw std::invalid_argument("[MidasEventProcessor] Init requires three JSON objects.");
@@ -43,10 +48,49 @@ void MidasEventProcessor::Init(const json& midas_receiver_config,
         {TR_START, 100}
     };
 
-    if (!midasReceiver_.IsInitialized()) {
-        midasReceiver_.init(config);
+    const json& event_source_config =
+        midas_event_processor_config.contains("event-source") && midas_event_processor_config["event-source"].is_object()
+            ? midas_event_processor_config["event-source"]
+            : json::object();
+    std::string sourceType = event_source_config.value("type", "live");
+    stopAtEnd_ = event_source_config.value("stop-at-end", false);
+
+    // A live source filters while taking events, so rejected ones do not use up the retrieval limit
+    if (midas_event_processor_config.contains("filter") && midas_event_processor_config["filter"].is_object()) {
+        auto filter = std::make_shared<EventHeaderFilter>(
+            EventHeaderFilterConfig::fromJson(midas_event_processor_config["filter"]));
+        if (filter->isActive()) {
+            spdlog::info("[MidasEventProcessor] Keeping only events with {}", filter->describe());
+            eventFilter_ = std::move(filter);
+        }
+    }
+
+    if (sourceType == "live") {
+        if (!midasReceiver_.isInitialized()) {
+            midasReceiver_.init(config);
+        }
+        // Every live processor reads through the one fan-out, which starts the receiver once
+        std::string consumerName = event_source_config.value("consumer-name", default_consumer_name);
+        LagPolicy lagPolicy;
+        if (event_source_config.contains("lag-policy") && event_source_config["lag-policy"].is_object()) {
+            lagPolicy = LagPolicy::fromJson(event_source_config["lag-policy"]);
+        }
+        EventFanOut& fanOut = MidasReceiverProvider::Instance().getFanOut();
+        if (!config.getAllEvents) {
+            // A receiver that samples events skips serial numbers by design
+            fanOut.setSerialGapTracking(false);
+        }
+        fanOut.start();
+        eventSource_ = std::make_unique<LiveEventSource>(
+            fanOut.subscribe(consumerName, event_source_config.value("queue-size", size_t(0))), lagPolicy,
+            eventFilter_);
+        liveSource_ = true;
+        spdlog::info("[MidasEventProcessor] Catching up on lag: {}", lagPolicy.describe());
+    } else {
+        eventSource_ = EventSource::createOffline(event_source_config);
+        liveSource_ = false;
     }
-    midasReceiver_.start();
+    spdlog::info("[MidasEventProcessor] Using {}", eventSource_->getName());
 
     configManager_ = std::make_shared<ConfigManager>();
     configManager_->reset();
@@ -60,8 +104,17 @@ void MidasEventProcessor::Init(const json& midas_receiver_config,
         throw std::runtime_error("[MidasEventProcessor] Failed to build pipeline.");
     }
 
+    // Sampling happens before unpacking too, so skipped events cost nothing
+    if (midas_event_processor_config.contains("sampling") && midas_event_processor_config["sampling"].is_object()) {
+        eventSampler_ = EventSampler::create(midas_event_processor_config["sampling"]);
+        if (eventSampler_) {
+            spdlog::info("[MidasEventProcessor] Sampling {}", eventSampler_->getName());
+        }
+    }
+
     if (midas_event_processor_config.is_object()) {
         clearProductsOnNewRun_ = midas_event_processor_config.value("clear-products-on-new-run", true);
+        stampSourceTime_ = midas_event_processor_config.value("stamp-source-time", false);
 
         if (midas_event_processor_config.contains("tags_to_omit_from_clear") &&
             midas_event_processor_config["tags_to_omit_from_clear"].is_array()) {
@@ -71,20 +124,21 @@ void MidasEventProcessor::Init(const json& midas_receiver_config,
         }
     }
 
-    // Immediately set internal run number from ODB
-    INT currentRun = getRunNumberFromOdb();
+    // Immediately set internal run number from ODB (offline sources know their own)
+    INT currentRun = liveSource_ ? getRunNumberFromOdb() : eventSource_->getRunNumber();
     if (currentRun >= 0) {
         lastRunNumber_ = currentRun;
         if (verbose > 0) {
-            spdlog::debug("[MidasEventProcessor] Initial run number retrieved from ODB: {}", lastRunNumber_);
+            spdlog::debug("[MidasEventProcessor] Initial run number: {}", lastRunNumber_);
         }
     } else {
         if (verbose > 0) {
-            spdlog::warn("[MidasEventProcessor] Failed to retrieve initial run number from ODB. Using -1.");
+            spdlog::warn("[MidasEventProcessor] Failed to retrieve initial run number. Using -1.");
         }
         lastRunNumber_ = -1;
     }
 
+    reportStart_ = std::chrono::steady_clock::now();
     initialized_ = true;
 }
 
@@ -150,34 +204,114 @@ std::vector<std::string> MidasEventProcessor::getProcessedOutput() {
     std::vector<std::string> out;
     if (!initialized_) return out;
 
-    handleTransitions();
+    if (liveSource_) {
+        handleTransitions();
+    } else {
+        INT sourceRun = eventSource_->getRunNumber();
+        if (sourceRun >= 0 && sourceRun != lastRunNumber_) {
+            setRunNumber(sourceRun);
+        }
+    }
 
-    auto timedEvents = midasReceiver_.getLatestEvents(numEventsPerRetrieval_, lastEventTimestamp_);
+    size_t retrievalLimit = eventSampler_ ? eventSampler_->getRetrievalLimit(numEventsPerRetrieval_)
+                                          : numEventsPerRetrieval_;
+    TimedEventList timedEvents = eventSource_->getLatestEvents(retrievalLimit);
+
+    if (liveSource_) {
+        uint64_t filteredCount = eventSource_->getFilteredCount();
+        eventsFilteredOutSinceReport_ += filteredCount - sourceFilteredCount_;
+        sourceFilteredCount_ = filteredCount;
+    } else if (eventFilter_) {
+        size_t retrievedCount = timedEvents.size();
+        timedEvents = eventFilter_->apply(std::move(timedEvents));
+        eventsFilteredOutSinceReport_ += retrievedCount - timedEvents.size();
+    }
+    size_t matchedCount = timedEvents.size();
+    if (eventSampler_) {
+        timedEvents = eventSampler_->select(std::move(timedEvents));
+        if (matchedCount > timedEvents.size()) {
+            eventsSampledOutSinceReport_ += matchedCount - timedEvents.size();
+        }
+    }
 
+    EventTracer& tracer = EventTracer::Instance();
     for (auto& timedEvent : timedEvents) {
+        uint64_t traceId = tracer.sampleEvent();
+        if (traceId) {
+            // The receiver stamps arrival on the wall clock; project it onto the monotonic clock
+            int64_t nowNs = EventTracer::now();
+            int64_t bufferedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now() - timedEvent->timestamp).count();
+            tracer.record(traceId, "receiver_buffering", nowNs - std::max<int64_t>(bufferedNs, 0), nowNs);
+        }
+
         InputBundle input;
 
         input.set("TMEvent", timedEvent->event);
         input.set("timestamp", timedEvent->timestamp);
         input.set("run_number", lastRunNumber_);
 
-        pipeline_->setInputData(std::move(input));
-        pipeline_->execute();
-
-        json serializedData = pipeline_->getDataProductManager().serializeAll();
+        {
+            TraceSpan span(traceId, "pipeline_execute");
+            pipeline_->setInputData(std::move(input));
+            pipeline_->execute();
+        }
 
-        json outJson;
-        outJson["run_number"] = lastRunNumber_;
-        outJson["data_products"] = serializedData;
+        // Stream the envelope straight into the output buffer, no intermediate DOM
+        TraceSpan span(traceId, "serialize_products");
+        eventWriter_.clear();
+        eventWriter_.beginObject();
+        if (stampSourceTime_) {
+            // Arrival time at the receiver, so subscribers can measure end-to-end latency
+            eventWriter_.key("source_time_ns").value(static_cast<int64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(timedEvent->timestamp.time_since_epoch()).count()));
+        }
+        eventWriter_
+            .key("run_number").value(lastRunNumber_)
+            .key("data_products").jsonValue(pipeline_->getDataProductManager().serializeAll())
+            .endObject();
 
-        out.push_back(outJson.dump());
+        out.push_back(eventWriter_.release());
     }
 
-    if (!timedEvents.empty()) {
-        lastEventTimestamp_ = timedEvents.back()->timestamp;
+    eventsSinceReport_ += timedEvents.size();
+    eventsProcessed_ += timedEvents.size();
+    reportThroughput();
+
+    if (stopAtEnd_ && eventSource_->isExhausted() && !SignalHandler::getInstance().isQuitSignalReceived()) {
+        spdlog::info("[MidasEventProcessor] {} exhausted after {} events, stopping.",
+                     eventSource_->getName(), eventsProcessed_);
+        SignalHandler::getInstance().requestQuit();
     }
 
     lastProcessedTime_ = std::chrono::system_clock::now();
 
     return out;
 }
+
+void MidasEventProcessor::reportThroughput() {
+    auto now = std::chrono::steady_clock::now();
+    auto elapsed = now - reportStart_;
+    if (elapsed < THROUGHPUT_REPORT_INTERVAL) {
+        return;
+    }
+
+    // Offline sources exist for benchmarking, so always report their rate
+    if (!liveSource_ || verbose > 0) {
+        double seconds = std::chrono::duration<double>(elapsed).count();
+        spdlog::info("[MidasEventProcessor] {}: {:.1f} events/s through pipeline and serialization",
+                     eventSource_->getName(), eventsSinceReport_ / seconds);
+        if (eventFilter_) {
+            spdlog::info("[MidasEventProcessor] {:.1f} events/s rejected by the header filter",
+                         eventsFilteredOutSinceReport_ / seconds);
+        }
+        if (eventSampler_) {
+            spdlog::info("[MidasEventProcessor] {:.1f} events/s skipped by sampling",
+                         eventsSampledOutSinceReport_ / seconds);
+        }
+    }
+    eventsSinceReport_ = 0;
+    eventsFilteredOutSinceReport_ = 0;
+    eventsSampledOutSinceReport_ = 0;
+    reportStart_ = now;
+}
@@ -1,4 +1,5 @@
 #include "processors/MidasOdbProcessor.h"
+#include "receivers/MidasReceiverProvider.h"
 #include <stdexcept>
 #include <spdlog/spdlog.h>
 
@@ -6,7 +7,7 @@ using json = nlohmann::json;
 
 MidasOdbProcessor::MidasOdbProcessor(int verbose)
     : GeneralProcessor(verbose),
-      midasReceiver_(MidasReceiver::getInstance()) {}
+      midasReceiver_(MidasReceiverProvider::Instance().get()) {}
 
 MidasOdbProcessor::~MidasOdbProcessor() {
     if (initialized_) {
@@ -26,7 +27,7 @@ void MidasOdbProcessor::Init(const json& midas_receiver_config) {
     config.clientName = midas_receiver_config.value("client-name", "MidasOdbProcessor");
     config.cmYieldTimeout = midas_receiver_config.value("yield-timeout-ms", 300);
 
-    if (!midasReceiver_.IsInitialized()) {
+    if (!midasReceiver_.isInitialized()) {
         midasReceiver_.init(config);
     }
     midasReceiver_.start();
@@ -0,0 +1,166 @@
+#include "processors/StatsProcessor.h"
+#include "receivers/MidasReceiverProvider.h"
+#include <fstream>
+#include <optional>
+#include <unistd.h>
+
+StatsProcessor::StatsProcessor(int verbose)
+    : GeneralProcessor(verbose), lastProcessedTime_(std::chrono::steady_clock::now()) {}
+
+bool StatsProcessor::isReadyToProcess() const {
+    auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - lastProcessedTime_).count();
+    return elapsedMs >= period;
+}
+
+std::vector<std::string> StatsProcessor::getProcessedOutput() {
+    auto now = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(now - lastProcessedTime_).count();
+    lastProcessedTime_ = now;
+
+    MetricsRegistry& registry = MetricsRegistry::Instance();
+    LoopMetrics& loop = registry.loop();
+
+    writer_.clear();
+    writer_.beginObject()
+        .key("timestamp_ns").value(static_cast<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count()))
+        .key("interval_s").value(seconds)
+        .key("rss_bytes").value(getResidentSetBytes())
+        .key("load_shedding_stage").value(
+            registry.gauge("publisher_load_shedding_stage", "Number of priorities currently shed").get());
+
+    writer_.key("loop").beginObject()
+        .key("deadline_misses").value(loop.deadlineMisses->get())
+        .key("deadline_misses_per_s").value(rate(loop.deadlineMisses, seconds));
+    writeLatency("duration_us", loop.duration);
+    writer_.endObject();
+
+    writeReceiver();
+
+    writer_.key("channels").beginObject();
+    for (const ChannelMetrics* channel : registry.getChannels()) {
+        uint64_t skipped = channel->messagesSkipped->get();
+        uint64_t rateLimited = channel->messagesRateLimited->get();
+        uint64_t overwritten = channel->entriesOverwritten->get();
+        uint64_t sendErrors = channel->sendErrors->get();
+
+        writer_.key(channel->channel).beginObject()
+            .key("messages_per_s").value(rate(channel->messagesPublished, seconds))
+            .key("bytes_per_s").value(rate(channel->bytesPublished, seconds))
+            .key("messages_published").value(channel->messagesPublished->get())
+            .key("bytes_published").value(channel->bytesPublished->get())
+            .key("drops").value(skipped + rateLimited + overwritten + sendErrors)
+            .key("skipped_on_break").value(skipped)
+            .key("rate_limited").value(rateLimited)
+            .key("entries_overwritten").value(overwritten)
+            .key("send_errors").value(sendErrors)
+            .key("buffer_depth").value(channel->bufferDepth->get())
+            .key("buffer_bytes").value(channel->bufferBytes->get())
+            .key("buffer_peak_bytes").value(channel->bufferPeakBytes->get())
+            .key("entries_evicted").value(channel->entriesEvicted->get())
+            .key("publishes_shed").value(channel->publishesShed->get())
+            .key("latency_budget_misses").value(channel->latencyBudgetMisses->get());
+        writeLatency("serialization_us", channel->serializationTime);
+        writeLatency("send_us", channel->sendTime);
+        writer_.endObject();
+    }
+    writer_.endObject();
+
+    writer_.key("processors").beginArray();
+    for (const ProcessorMetrics* processor : registry.getProcessors()) {
+        writer_.beginObject()
+            .key("channel").value(processor->channel)
+            .key("processor").value(processor->processor)
+            .key("index").value(processor->index)
+            .key("runs_per_s").value(rate(processor->runs, seconds))
+            .key("outputs_per_s").value(rate(processor->outputs, seconds))
+            .key("bytes_per_s").value(rate(processor->outputBytes, seconds))
+            .key("deadline_misses").value(processor->deadlineMisses->get())
+            .key("runs_shed").value(processor->runsShed->get())
+            .key("outputs_suppressed").value(processor->outputsSuppressed->get());
+        writeLatency("processing_us", processor->processingTime);
+        writer_.endObject();
+    }
+    writer_.endArray();
+
+    writer_.endObject();
+
+    std::vector<std::string> out;
+    out.push_back(writer_.release());
+    return out;
+}
+
+double StatsProcessor::rate(const Counter* counter, double seconds) {
+    uint64_t current = counter->get();
+    uint64_t& previous = previousCounts_[counter];
+    uint64_t delta = current >= previous ? current - previous : 0;
+    previous = current;
+    return seconds > 0 ? delta / seconds : 0.0;
+}
+
+void StatsProcessor::writeLatency(const char* key, const Histogram* histogram) {
+    HistogramSnapshot current = histogram->snapshot();
+    HistogramSnapshot window = current.since(previousHistograms_[histogram]);
+    previousHistograms_[histogram] = std::move(current);
+
+    writer_.key(key).beginObject()
+        .key("count").value(window.count)
+        .key("p50").value(window.quantile(0.5) / 1000.0)
+        .key("p99").value(window.quantile(0.99) / 1000.0)
+        .key("p99.9").value(window.quantile(0.999) / 1000.0)
+        .key("max").value(window.max() / 1000.0)
+        .endObject();
+}
+
+void StatsProcessor::writeReceiver() {
+    MidasReceiverInterface& receiver = MidasReceiverProvider::Instance().get();
+    if (!receiver.isInitialized()) {
+        return;
+    }
+
+    size_t buffered = receiver.getBufferedEventCount();
+    size_t capacity = receiver.getBufferCapacity();
+    writer_.key("receiver").beginObject()
+        .key("buffered_events").value(buffered)
+        .key("buffer_capacity").value(capacity)
+        .key("buffer_fill").value(capacity > 0 ? static_cast<double>(buffered) / capacity : 0.0);
+    std::optional<uint64_t> dropped = receiver.getDroppedEventCount();
+    writer_.key("dropped_events");
+    if (dropped) {
+        writer_.value(*dropped);
+    } else {
+        writer_.nullValue();
+    }
+
+    EventFanOut& fanOut = MidasReceiverProvider::Instance().getFanOut();
+    writer_.key("serial_gaps");
+    if (fanOut.isTrackingSerialGaps()) {
+        writer_.value(fanOut.getSerialGapCount());
+    } else {
+        writer_.nullValue();
+    }
+    writer_.key("consumers").beginObject();
+    for (const auto& consumer : fanOut.getConsumers()) {
+        writer_.key(consumer->getName()).beginObject()
+            .key("queued_events").value(consumer->getQueuedCount())
+            .key("dropped_events").value(consumer->getDroppedCount())
+            .key("skipped_events").value(consumer->getSkippedCount())
+            .key("lag_ms").value(static_cast<int64_t>(consumer->getLag().count()))
+            .endObject();
+    }
+    writer_.endObject();
+
+    writer_.endObject();
+}
+
+size_t StatsProcessor::getResidentSetBytes() {
+    // Second field of statm is the resident set in pages
+    std::ifstream statm("/proc/self/statm");
+    size_t totalPages = 0;
+    size_t residentPages = 0;
+    if (!(statm >> totalPages >> residentPages)) {
+        return 0;
+    }
+    return residentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
@@ -0,0 +1,95 @@
+#include "processors/StreamingCommandProcessor.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <sys/wait.h>
+
+StreamingCommandProcessor::StreamingCommandProcessor(int verbose)
+    : GeneralProcessor(verbose) {}
+
+StreamingCommandProcessor::~StreamingCommandProcessor() {
+    // The Subprocess destructor stops the command
+}
+
+void StreamingCommandProcessor::Init(const nlohmann::json& config) {
+    std::string command = config.value("command", "");
+    if (command.empty()) {
+        throw std::invalid_argument("[StreamingCommandProcessor] 'command' is required.");
+    }
+    std::string delimiter = config.value("delimiter", records_.getDelimiter());
+    if (delimiter.empty()) {
+        throw std::invalid_argument("[StreamingCommandProcessor] 'delimiter' must not be empty.");
+    }
+    records_ = RecordSplitter(delimiter, config.value("max-record-bytes", records_.getMaxRecordBytes()));
+    maxReadBytes_ = config.value("max-read-bytes", maxReadBytes_);
+    if (maxReadBytes_ == 0) {
+        throw std::invalid_argument("[StreamingCommandProcessor] 'max-read-bytes' must be positive.");
+    }
+    initialBackoff_ = std::chrono::milliseconds(config.value("restart-backoff-ms", int64_t(initialBackoff_.count())));
+    maxBackoff_ = std::max(initialBackoff_,
+                           std::chrono::milliseconds(config.value("max-restart-backoff-ms", int64_t(maxBackoff_.count()))));
+    backoff_ = initialBackoff_;
+
+    process_ = std::make_unique<Subprocess>(command);
+    nextStart_ = std::chrono::steady_clock::now();
+    spdlog::info("[StreamingCommandProcessor] Streaming the output of '{}'", command);
+}
+
+bool StreamingCommandProcessor::isReadyToProcess() const {
+    if (!process_) return false;
+    return std::chrono::steady_clock::now() - lastProcessedTime_ >= std::chrono::milliseconds(period);
+}
+
+std::vector<std::string> StreamingCommandProcessor::getProcessedOutput() {
+    std::vector<std::string> out;
+    lastProcessedTime_ = std::chrono::steady_clock::now();
+    ensureRunning();
+
+    // Whatever is left in the pipe past the cap is read on the next run
+    process_->readAvailable(records_.buffer(), maxReadBytes_);
+    records_.split(out);
+    if (running_ && process_->isAtEnd()) {
+        handleExit(out);
+    }
+    return out;
+}
+
+void StreamingCommandProcessor::ensureRunning() {
+    auto now = std::chrono::steady_clock::now();
+    if (running_ || now < nextStart_) {
+        return;
+    }
+    if (process_->start()) {
+        running_ = true;
+        startedAt_ = now;
+    } else {
+        // Could not even spawn; retry later like a failed run
+        int error = process_->getStartError();
+        spdlog::warn("[StreamingCommandProcessor] Failed to start '{}': {}, retrying in {} ms",
+                     process_->getCommand(), error != 0 ? std::strerror(error) : "could not be started",
+                     backoff_.count());
+        nextStart_ = now + backoff_;
+        backoff_ = std::min(backoff_ * 2, maxBackoff_);
+    }
+}
+
+void StreamingCommandProcessor::handleExit(std::vector<std::string>& out) {
+    // Closing stdout ends the stream even if the command lingers, so make sure it is gone
+    process_->stop();
+    running_ = false;
+    records_.flush(out);
+
+    // A command that ran for a while before exiting starts over with the shortest backoff
+    auto now = std::chrono::steady_clock::now();
+    if (now - startedAt_ >= maxBackoff_) {
+        backoff_ = initialBackoff_;
+    }
+    int status = process_->getExitStatus();
+    ++restarts_;
+    spdlog::warn("[StreamingCommandProcessor] '{}' exited with {} {}, restart #{} in {} ms",
+                 process_->getCommand(), WIFSIGNALED(status) ? "signal" : "status",
+                 WIFSIGNALED(status) ? WTERMSIG(status) : WEXITSTATUS(status), restarts_, backoff_.count());
+    nextStart_ = now + backoff_;
+    backoff_ = std::min(backoff_ * 2, maxBackoff_);
+}
@@ -0,0 +1,316 @@
+#include "receivers/EventFanOut.h"
+#include "event_sources/EventSource.h"
+#include "event_sources/EventHeaderFilter.h"
+#include "metrics/MetricsRegistry.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+
+const size_t DEFAULT_FAN_OUT_BATCH = 1000;
+
+EventConsumer::EventConsumer(EventFanOut& fanOut, const std::string& name, size_t capacity, uint64_t nextSequence)
+    : fanOut_(fanOut), name_(name), capacity_(std::max<size_t>(capacity, 1)), nextSequence_(nextSequence) {
+    MetricsRegistry& registry = MetricsRegistry::Instance();
+    MetricLabels labels = {{"consumer", name}};
+    queueDepth_ = &registry.gauge("publisher_fanout_queue_depth", "Events received but not yet taken by a consumer", labels);
+    lagMs_ = &registry.gauge("publisher_fanout_lag_ms", "Age of the oldest event not yet taken by a consumer", labels);
+    delivered_ = &registry.counter("publisher_fanout_delivered_total", "Events taken by a consumer", labels);
+    droppedCounter_ = &registry.counter("publisher_fanout_dropped_total", "Events a consumer skipped for falling behind", labels);
+    skippedCounter_ = &registry.counter("publisher_fanout_skipped_total", "Events a consumer skipped to catch up", labels);
+}
+
+TimedEventList EventConsumer::take(size_t maxEvents, const EventHeaderFilter* filter) {
+    std::lock_guard<std::mutex> lock(fanOut_.mutex_);
+    fanOut_.pollLocked();
+    enforceCapacity();
+
+    uint64_t end = fanOut_.firstSequence_ + fanOut_.log_.size();
+    TimedEventList events;
+    if (filter) {
+        // Rejected events are consumed but not counted, so a rare accepted event is not starved
+        while (nextSequence_ < end && events.size() < maxEvents) {
+            const TimedEventPtr& event = fanOut_.log_[nextSequence_ - fanOut_.firstSequence_];
+            ++nextSequence_;
+            if (filter->accepts(eventOf(*event))) {
+                events.push_back(event);
+            } else {
+                ++filtered_;
+            }
+        }
+    } else {
+        size_t count = static_cast<size_t>(std::min<uint64_t>(maxEvents, end - nextSequence_));
+        auto first = fanOut_.log_.begin() + static_cast<std::ptrdiff_t>(nextSequence_ - fanOut_.firstSequence_);
+        events.assign(first, first + static_cast<std::ptrdiff_t>(count));
+        nextSequence_ += count;
+    }
+
+    delivered_->add(events.size());
+    updateLag();
+    fanOut_.trimLog();
+    return events;
+}
+
+size_t EventConsumer::poll() {
+    std::lock_guard<std::mutex> lock(fanOut_.mutex_);
+    fanOut_.pollLocked();
+    enforceCapacity();
+    return static_cast<size_t>(fanOut_.firstSequence_ + fanOut_.log_.size() - nextSequence_);
+}
+
+uint64_t EventConsumer::skip(size_t keep, std::chrono::system_clock::time_point notBefore,
+                             const EventHeaderFilter* filter) {
+    std::lock_guard<std::mutex> lock(fanOut_.mutex_);
+    fanOut_.pollLocked();
+    enforceCapacity();
+
+    uint64_t end = fanOut_.firstSequence_ + fanOut_.log_.size();
+    uint64_t target = std::max<uint64_t>(nextSequence_, end > keep ? end - keep : 0);
+    if (filter && target > nextSequence_) {
+        // Keep the newest accepted events, however many rejected ones arrived after them
+        uint64_t kept = 0;
+        target = end;
+        while (target > nextSequence_ && kept < keep) {
+            --target;
+            if (filter->accepts(eventOf(*fanOut_.log_[target - fanOut_.firstSequence_]))) {
+                ++kept;
+            }
+        }
+    }
+    // The log is in receive order, so the events that are too old are all at the front
+    while (target < end && fanOut_.log_[target - fanOut_.firstSequence_]->timestamp < notBefore) {
+        ++target;
+    }
+
+    uint64_t skipped = target - nextSequence_;
+    if (skipped > 0) {
+        nextSequence_ = target;
+        skipped_ += skipped;
+        skippedCounter_->add(skipped);
+        fanOut_.trimLog();
+    }
+    updateLag();
+    return skipped;
+}
+
+const std::string& EventConsumer::getName() const {
+    return name_;
+}
+
+size_t EventConsumer::getQueuedCount() const {
+    std::lock_guard<std::mutex> lock(fanOut_.mutex_);
+    return static_cast<size_t>(fanOut_.firstSequence_ + fanOut_.log_.size() - nextSequence_);
+}
+
+uint64_t EventConsumer::getDroppedCount() const {
+    std::lock_guard<std::mutex> lock(fanOut_.mutex_);
+    return dropped_;
+}
+
+uint64_t EventConsumer::getNextSequence() const {
+    std::lock_guard<std::mutex> lock(fanOut_.mutex_);
+    return nextSequence_;
+}
+
+uint64_t EventConsumer::getSkippedCount() const {
+    std::lock_guard<std::mutex> lock(fanOut_.mutex_);
+    return skipped_;
+}
+
+uint64_t EventConsumer::getFilteredCount() const {
+    std::lock_guard<std::mutex> lock(fanOut_.mutex_);
+    return filtered_;
+}
+
+std::chrono::milliseconds EventConsumer::getLag() const {
+    std::lock_guard<std::mutex> lock(fanOut_.mutex_);
+    return getLagLocked();
+}
+
+std::chrono::milliseconds EventConsumer::getLagLocked() const {
+    uint64_t end = fanOut_.firstSequence_ + fanOut_.log_.size();
+    if (nextSequence_ >= end) {
+        return std::chrono::milliseconds(0);
+    }
+    auto age = std::chrono::system_clock::now() - fanOut_.log_[nextSequence_ - fanOut_.firstSequence_]->timestamp;
+    return std::max(std::chrono::duration_cast<std::chrono::milliseconds>(age), std::chrono::milliseconds(0));
+}
+
+void EventConsumer::updateLag() {
+    queueDepth_->set(static_cast<int64_t>(fanOut_.firstSequence_ + fanOut_.log_.size() - nextSequence_));
+    lagMs_->set(static_cast<int64_t>(getLagLocked().count()));
+}
+
+void EventConsumer::enforceCapacity() {
+    uint64_t end = fanOut_.firstSequence_ + fanOut_.log_.size();
+    uint64_t floor = std::max(fanOut_.firstSequence_, end > capacity_ ? end - capacity_ : 0);
+    if (nextSequence_ < floor) {
+        uint64_t skipped = floor - nextSequence_;
+        dropped_ += skipped;
+        droppedCounter_->add(skipped);
+        nextSequence_ = floor;
+    }
+    updateLag();
+}
+
+EventFanOut::EventFanOut(MidasReceiverInterface& receiver)
+    : receiver_(receiver), cursor_(std::chrono::system_clock::now()) {
+    MetricsRegistry& registry = MetricsRegistry::Instance();
+    received_ = &registry.counter("publisher_fanout_received_total", "Events pulled from the MIDAS receiver");
+    serialGapCounter_ = &registry.counter("publisher_fanout_serial_gaps_total",
+                                          "Events missing between consecutive serial numbers of an event ID");
+}
+
+void EventFanOut::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (started_) {
+        return;
+    }
+    if (!receiver_.isRunning()) {
+        receiver_.start();
+    }
+    started_ = true;
+}
+
+std::shared_ptr<EventConsumer> EventFanOut::subscribe(const std::string& name, size_t queueCapacity) {
+    size_t capacity = queueCapacity > 0 ? queueCapacity : getBatchSize();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Receive whatever is pending first, so the new consumer only sees events from now on
+    pollLocked();
+    std::shared_ptr<EventConsumer> consumer(
+        new EventConsumer(*this, name, capacity, firstSequence_ + log_.size()));
+    consumers_.push_back(consumer);
+    spdlog::info("[EventFanOut] Consumer '{}' subscribed with room for {} unread events", name, capacity);
+    return consumer;
+}
+
+size_t EventFanOut::poll() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pollLocked();
+}
+
+uint64_t EventFanOut::getNextSequence() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return firstSequence_ + log_.size();
+}
+
+uint64_t EventFanOut::getSerialGapCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return serialGaps_;
+}
+
+double EventFanOut::getFill() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t end = firstSequence_ + log_.size();
+    double fill = 0.0;
+    for (const auto& weak : consumers_) {
+        if (auto consumer = weak.lock()) {
+            fill = std::max(fill, static_cast<double>(end - consumer->nextSequence_) / consumer->capacity_);
+        }
+    }
+    return fill;
+}
+
+void EventFanOut::setSerialGapTracking(bool enabled) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    trackSerialGaps_ = enabled;
+    lastSerials_.clear();
+}
+
+bool EventFanOut::isTrackingSerialGaps() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return trackSerialGaps_;
+}
+
+std::vector<std::shared_ptr<const EventConsumer>> EventFanOut::getConsumers() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::shared_ptr<const EventConsumer>> result;
+    for (const auto& weak : consumers_) {
+        if (auto consumer = weak.lock()) {
+            result.push_back(std::move(consumer));
+        }
+    }
+    return result;
+}
+
+size_t EventFanOut::pollLocked() {
+    consumers_.erase(std::remove_if(consumers_.begin(), consumers_.end(),
+                                    [](const std::weak_ptr<EventConsumer>& weak) { return weak.expired(); }),
+                     consumers_.end());
+    if (!receiver_.isInitialized()) {
+        return 0;
+    }
+
+    // Ask again for the cursor's own timestamp, so events sharing it are not skipped
+    auto since = cursor_ - std::chrono::system_clock::duration(1);
+    TimedEventList events = receiver_.getLatestEvents(getBatchSize() + cursorEvents_.size(), since);
+
+    size_t added = 0;
+    for (auto& event : events) {
+        if (event->timestamp <= cursor_ && isRepeat(event)) {
+            continue;
+        }
+        if (event->timestamp > cursor_) {
+            cursor_ = event->timestamp;
+            cursorEvents_.clear();
+        }
+
+        const TMEvent& header = eventOf(*event);
+        cursorEvents_.emplace_back(header.event_id, header.serial_number);
+        if (trackSerialGaps_) {
+            trackSerial(header);
+        }
+        log_.push_back(std::move(event));
+        ++added;
+    }
+    if (added == 0) {
+        return 0;
+    }
+    received_->add(added);
+
+    for (const auto& weak : consumers_) {
+        if (auto consumer = weak.lock()) {
+            consumer->enforceCapacity();
+        }
+    }
+    trimLog();
+    return added;
+}
+
+bool EventFanOut::isRepeat(const TimedEventPtr& event) const {
+    const TMEvent& header = eventOf(*event);
+    return std::find(cursorEvents_.begin(), cursorEvents_.end(),
+                     std::make_pair(header.event_id, header.serial_number)) != cursorEvents_.end();
+}
+
+void EventFanOut::trackSerial(const TMEvent& event) {
+    auto [it, inserted] = lastSerials_.try_emplace(event.event_id, event.serial_number);
+    if (inserted) {
+        return;
+    }
+    // Serial numbers restart with each run, so only count forward jumps
+    if (event.serial_number > uint64_t(it->second) + 1) {
+        uint64_t gap = event.serial_number - it->second - 1;
+        serialGaps_ += gap;
+        serialGapCounter_->add(gap);
+    }
+    it->second = event.serial_number;
+}
+
+void EventFanOut::trimLog() {
+    uint64_t end = firstSequence_ + log_.size();
+    uint64_t oldestUnread = end;
+    for (const auto& weak : consumers_) {
+        if (auto consumer = weak.lock()) {
+            oldestUnread = std::min(oldestUnread, consumer->nextSequence_);
+        }
+    }
+    while (firstSequence_ < oldestUnread) {
+        log_.pop_front();
+        ++firstSequence_;
+    }
+}
+
+size_t EventFanOut::getBatchSize() {
+    size_t capacity = receiver_.getBufferCapacity();
+    return capacity > 0 ? capacity : DEFAULT_FAN_OUT_BATCH;
+}
@@ -0,0 +1,181 @@
+#include "receivers/FakeMidasReceiver.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+using json = nlohmann::json;
+
+FakeMidasReceiver::FakeMidasReceiver(const json& config)
+    : bufferSize_(config.value("buffer-size", 1000)),
+      pollInterval_(config.value("poll-interval-ms", 1)),
+      runLengthSeconds_(config.value("run-length-s", 0.0)),
+      runNumber_(config.value("first-run-number", 1)),
+      initialized_(false), running_(false), dropped_(0) {
+
+    json eventsConfig = config.contains("events") && config["events"].is_object()
+        ? config["events"]
+        : json{{"type", "synthetic"}, {"rate-hz", 1000.0}};
+    generator_ = EventSource::createOffline(eventsConfig);
+
+    if (config.contains("odb-file")) {
+        std::string odbFile = config["odb-file"].get<std::string>();
+        std::ifstream odbStream(odbFile);
+        if (!odbStream) {
+            throw std::runtime_error("[FakeMidasReceiver] Failed to open ODB file: " + odbFile);
+        }
+        odbStream >> odb_;
+    } else if (config.contains("odb") && config["odb"].is_object()) {
+        odb_ = config["odb"];
+    } else {
+        odb_ = {{"Experiment", {{"Name", "fake"}}}};
+    }
+    odb_["Runinfo"]["Run number"] = runNumber_;
+    odb_["Runinfo"]["State"] = 3;
+
+    // Filler so ODB dumps can be made as large as the real thing
+    size_t odbSizeBytes = config.value("odb-size-bytes", 0);
+    if (odbSizeBytes > 0) {
+        json& filler = odb_["Equipment"]["Fake"]["Variables"]["Filler"];
+        filler = json::array();
+        for (size_t bytes = 0; bytes < odbSizeBytes; bytes += 11) {
+            filler.push_back(1234567890);
+        }
+    }
+}
+
+FakeMidasReceiver::~FakeMidasReceiver() {
+    stop();
+}
+
+bool FakeMidasReceiver::isInitialized() {
+    return initialized_.load();
+}
+
+void FakeMidasReceiver::init(const MidasReceiverConfig& config) {
+    (void)config;
+    initialized_ = true;
+    spdlog::info("[FakeMidasReceiver] Serving {} instead of a MIDAS experiment", generator_->getName());
+}
+
+void FakeMidasReceiver::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+    runStart_ = std::chrono::steady_clock::now();
+    producer_ = std::thread(&FakeMidasReceiver::producerLoop, this);
+}
+
+void FakeMidasReceiver::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    if (producer_.joinable()) {
+        producer_.join();
+    }
+}
+
+bool FakeMidasReceiver::isRunning() {
+    return running_.load();
+}
+
+bool FakeMidasReceiver::isListeningForEvents() {
+    return running_.load() && !generator_->isExhausted();
+}
+
+TimedEventList FakeMidasReceiver::getLatestEvents(size_t maxEvents, std::chrono::system_clock::time_point since) {
+    TimedEventList result;
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto first = std::upper_bound(events_.begin(), events_.end(), since,
+        [](const auto& time, const TimedEventPtr& event) { return time < event->timestamp; });
+    for (auto it = first; it != events_.end() && result.size() < maxEvents; ++it) {
+        result.push_back(*it);
+    }
+    return result;
+}
+
+TransitionList FakeMidasReceiver::getLatestTransitions(size_t maxTransitions, std::chrono::system_clock::time_point since) {
+    TransitionList result;
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (const auto& transition : transitions_) {
+        if (transition.timestamp > since && result.size() < maxTransitions) {
+            result.push_back(transition);
+        }
+    }
+    return result;
+}
+
+std::string FakeMidasReceiver::getOdb(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (path.empty() || path == "/") {
+        return odb_.dump();
+    }
+
+    json::json_pointer pointer(path);
+    if (!odb_.contains(pointer)) {
+        return "{}";
+    }
+
+    // Like MIDAS, a key is returned wrapped in an object named after it
+    const json& value = odb_.at(pointer);
+    if (value.is_object()) {
+        return value.dump();
+    }
+    return json{{path.substr(path.find_last_of('/') + 1), value}}.dump();
+}
+
+size_t FakeMidasReceiver::getBufferedEventCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return events_.size();
+}
+
+size_t FakeMidasReceiver::getBufferCapacity() {
+    return bufferSize_;
+}
+
+std::optional<uint64_t> FakeMidasReceiver::getDroppedEventCount() {
+    return dropped_.load();
+}
+
+void FakeMidasReceiver::producerLoop() {
+    while (running_.load()) {
+        auto batch = generator_->getLatestEvents(bufferSize_);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto& event : batch) {
+                // Stamp on arrival, like the real receiver does
+                event->timestamp = std::chrono::system_clock::now();
+                events_.push_back(std::move(event));
+            }
+            while (events_.size() > bufferSize_) {
+                events_.pop_front();
+                dropped_++;
+            }
+
+            if (runLengthSeconds_ > 0 &&
+                std::chrono::steady_clock::now() - runStart_ >= std::chrono::duration<double>(runLengthSeconds_)) {
+                startNewRun(std::chrono::system_clock::now());
+            }
+        }
+
+        std::this_thread::sleep_for(pollInterval_);
+    }
+}
+
+void FakeMidasReceiver::startNewRun(std::chrono::system_clock::time_point now) {
+    runNumber_++;
+    runStart_ = std::chrono::steady_clock::now();
+    odb_["Runinfo"]["Run number"] = runNumber_;
+
+    TransitionType transition{};
+    transition.run_number = runNumber_;
+    transition.timestamp = now;
+    transitions_.push_back(transition);
+    if (transitions_.size() > 100) {
+        transitions_.erase(transitions_.begin());
+    }
+}
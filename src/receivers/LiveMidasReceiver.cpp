@@ -0,0 +1,59 @@
+#include "receivers/LiveMidasReceiver.h"
+#include <cstdint>
+
+LiveMidasReceiver::LiveMidasReceiver()
+    : receiver_(MidasReceiver::getInstance()), bufferCapacity_(0) {}
+
+bool LiveMidasReceiver::isInitialized() {
+    return receiver_.IsInitialized();
+}
+
+void LiveMidasReceiver::init(const MidasReceiverConfig& config) {
+    bufferCapacity_ = config.maxBufferSize;
+    receiver_.init(config);
+}
+
+void LiveMidasReceiver::start() {
+    receiver_.start();
+}
+
+void LiveMidasReceiver::stop() {
+    receiver_.stop();
+}
+
+bool LiveMidasReceiver::isRunning() {
+    return receiver_.IsRunning();
+}
+
+bool LiveMidasReceiver::isListeningForEvents() {
+    return receiver_.isListeningForEvents();
+}
+
+TimedEventList LiveMidasReceiver::getLatestEvents(size_t maxEvents, std::chrono::system_clock::time_point since) {
+    return receiver_.getLatestEvents(maxEvents, since);
+}
+
+TransitionList LiveMidasReceiver::getLatestTransitions(size_t maxTransitions, std::chrono::system_clock::time_point since) {
+    return receiver_.getLatestTransitions(maxTransitions, since);
+}
+
+std::string LiveMidasReceiver::getOdb(const std::string& path) {
+    return receiver_.getOdb(path);
+}
+
+size_t LiveMidasReceiver::getBufferedEventCount() {
+    if (!receiver_.IsInitialized()) {
+        return 0;
+    }
+    size_t capacity = bufferCapacity_ > 0 ? bufferCapacity_ : SIZE_MAX;
+    return receiver_.getLatestEvents(capacity, std::chrono::system_clock::time_point{}).size();
+}
+
+size_t LiveMidasReceiver::getBufferCapacity() {
+    return bufferCapacity_;
+}
+
+std::optional<uint64_t> LiveMidasReceiver::getDroppedEventCount() {
+    // The MIDAS receiver overwrites its ring buffer without counting what it loses
+    return std::nullopt;
+}
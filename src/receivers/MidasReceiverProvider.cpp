@@ -0,0 +1,42 @@
+#include "receivers/MidasReceiverProvider.h"
+#include "receivers/LiveMidasReceiver.h"
+#include "receivers/FakeMidasReceiver.h"
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+
+MidasReceiverProvider& MidasReceiverProvider::Instance() {
+    static MidasReceiverProvider provider;
+    return provider;
+}
+
+void MidasReceiverProvider::configure(const nlohmann::json& config) {
+    std::string type = config.value("type", "live");
+    fanOut_.reset();
+
+    if (type == "live") {
+        receiver_ = std::make_unique<LiveMidasReceiver>();
+    } else if (type == "fake") {
+        spdlog::warn("Using the fake MIDAS receiver; no experiment data will be published");
+        receiver_ = std::make_unique<FakeMidasReceiver>(config);
+    } else {
+        throw std::invalid_argument("Unknown midas-receiver type: " + type);
+    }
+}
+
+MidasReceiverInterface& MidasReceiverProvider::get() {
+    if (!receiver_) {
+        receiver_ = std::make_unique<LiveMidasReceiver>();
+    }
+    return *receiver_;
+}
+
+EventFanOut& MidasReceiverProvider::getFanOut() {
+    if (!fanOut_) {
+        fanOut_ = std::make_unique<EventFanOut>(get());
+    }
+    return *fanOut_;
+}
+
+bool MidasReceiverProvider::hasFanOut() const {
+    return fanOut_ != nullptr;
+}
@@ -0,0 +1,247 @@
+#include "utilities/JsonWriter.h"
+#include <charconv>
+#include <cmath>
+#include <utility>
+
+namespace {
+
+// U+FFFD REPLACEMENT CHARACTER, written in place of bytes that are not valid UTF-8
+const char UTF8_REPLACEMENT[] = "\xEF\xBF\xBD";
+
+/**
+ * @brief Measures the UTF-8 sequence starting at a non-ASCII byte.
+ * @param str The string.
+ * @param i Index of the sequence's lead byte.
+ * @param length Set to the sequence length if it is valid, otherwise to the length of
+ *        its longest valid prefix, which is replaced as a whole.
+ * @return True if the sequence is valid UTF-8 (no overlong forms, surrogates or code
+ *         points above U+10FFFF).
+ */
+bool measureUtf8(std::string_view str, size_t i, size_t& length) {
+    unsigned char lead = static_cast<unsigned char>(str[i]);
+    size_t expected = 0;
+    // Valid range of the first continuation byte; the others are always 0x80-0xBF
+    unsigned char low = 0x80;
+    unsigned char high = 0xBF;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        expected = 2;
+    } else if (lead == 0xE0) {
+        expected = 3;
+        low = 0xA0;
+    } else if (lead == 0xED) {
+        expected = 3;
+        high = 0x9F;
+    } else if (lead >= 0xE1 && lead <= 0xEF) {
+        expected = 3;
+    } else if (lead == 0xF0) {
+        expected = 4;
+        low = 0x90;
+    } else if (lead >= 0xF1 && lead <= 0xF3) {
+        expected = 4;
+    } else if (lead == 0xF4) {
+        expected = 4;
+        high = 0x8F;
+    }
+
+    length = 1;
+    if (expected == 0) {
+        return false;
+    }
+    while (length < expected) {
+        if (i + length >= str.size()) {
+            return false;
+        }
+        unsigned char c = static_cast<unsigned char>(str[i + length]);
+        if (c < low || c > high) {
+            return false;
+        }
+        low = 0x80;
+        high = 0xBF;
+        ++length;
+    }
+    return true;
+}
+
+} // namespace
+
+JsonWriter::JsonWriter(size_t reserveBytes)
+    : afterKey_(false), lastReleasedSize_(0) {
+    buffer_.reserve(reserveBytes);
+}
+
+void JsonWriter::clear() {
+    buffer_.clear();
+    hasElements_.clear();
+    afterKey_ = false;
+    if (buffer_.capacity() < lastReleasedSize_) {
+        buffer_.reserve(lastReleasedSize_);
+    }
+}
+
+JsonWriter& JsonWriter::beginObject() {
+    beforeValue();
+    buffer_ += '{';
+    hasElements_.push_back(false);
+    return *this;
+}
+
+JsonWriter& JsonWriter::endObject() {
+    buffer_ += '}';
+    hasElements_.pop_back();
+    return *this;
+}
+
+JsonWriter& JsonWriter::beginArray() {
+    beforeValue();
+    buffer_ += '[';
+    hasElements_.push_back(false);
+    return *this;
+}
+
+JsonWriter& JsonWriter::endArray() {
+    buffer_ += ']';
+    hasElements_.pop_back();
+    return *this;
+}
+
+JsonWriter& JsonWriter::key(std::string_view name) {
+    beforeValue();
+    appendEscaped(name);
+    buffer_ += ':';
+    afterKey_ = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(std::string_view str) {
+    beforeValue();
+    appendEscaped(str);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(const char* str) {
+    return value(std::string_view(str));
+}
+
+JsonWriter& JsonWriter::value(bool b) {
+    beforeValue();
+    buffer_ += b ? "true" : "false";
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(double d) {
+    if (!std::isfinite(d)) {
+        return nullValue();
+    }
+    beforeValue();
+    char chars[32];
+    auto result = std::to_chars(chars, chars + sizeof(chars), d);
+    buffer_.append(chars, result.ptr);
+    return *this;
+}
+
+JsonWriter& JsonWriter::nullValue() {
+    beforeValue();
+    buffer_ += "null";
+    return *this;
+}
+
+JsonWriter& JsonWriter::rawValue(std::string_view json) {
+    beforeValue();
+    buffer_ += json;
+    return *this;
+}
+
+JsonWriter& JsonWriter::jsonValue(const nlohmann::json& json) {
+    beforeValue();
+    // Invalid UTF-8 is replaced rather than thrown on, as in appendEscaped()
+    buffer_ += json.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+    return *this;
+}
+
+const std::string& JsonWriter::str() const {
+    return buffer_;
+}
+
+size_t JsonWriter::size() const {
+    return buffer_.size();
+}
+
+std::string JsonWriter::release() {
+    lastReleasedSize_ = buffer_.size();
+    std::string out = std::move(buffer_);
+    buffer_ = std::string();
+    hasElements_.clear();
+    afterKey_ = false;
+    return out;
+}
+
+void JsonWriter::beforeValue() {
+    if (afterKey_) {
+        afterKey_ = false;
+        return;
+    }
+    if (!hasElements_.empty()) {
+        if (hasElements_.back()) {
+            buffer_ += ',';
+        }
+        hasElements_.back() = true;
+    }
+}
+
+void JsonWriter::appendEscaped(std::string_view str) {
+    static const char hex[] = "0123456789abcdef";
+
+    buffer_ += '"';
+    size_t runStart = 0;
+    for (size_t i = 0; i < str.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(str[i]);
+        if (c >= 0x20 && c < 0x80 && c != '"' && c != '\\') {
+            continue;
+        }
+
+        if (c >= 0x80) {
+            size_t length = 0;
+            bool valid = measureUtf8(str, i, length);
+            if (!valid) {
+                buffer_.append(str.data() + runStart, i - runStart);
+                buffer_ += UTF8_REPLACEMENT;
+                runStart = i + length;
+            }
+            i += length - 1;
+            continue;
+        }
+
+        // Flush the run of characters that need no escaping
+        buffer_.append(str.data() + runStart, i - runStart);
+        runStart = i + 1;
+
+        switch (c) {
+            case '"':  buffer_ += "\\\""; break;
+            case '\\': buffer_ += "\\\\"; break;
+            case '\b': buffer_ += "\\b"; break;
+            case '\f': buffer_ += "\\f"; break;
+            case '\n': buffer_ += "\\n"; break;
+            case '\r': buffer_ += "\\r"; break;
+            case '\t': buffer_ += "\\t"; break;
+            default:
+                buffer_ += "\\u00";
+                buffer_ += hex[c >> 4];
+                buffer_ += hex[c & 0x0f];
+                break;
+        }
+    }
+    buffer_.append(str.data() + runStart, str.size() - runStart);
+    buffer_ += '"';
+}
+
+void JsonWriter::appendInteger(long long n) {
+    char chars[24];
+    auto result = std::to_chars(chars, chars + sizeof(chars), n);
+    buffer_.append(chars, result.ptr);
+}
+
+void JsonWriter::appendInteger(unsigned long long n) {
+    char chars[24];
+    auto result = std::to_chars(chars, chars + sizeof(chars), n);
+    buffer_.append(chars, result.ptr);
+}
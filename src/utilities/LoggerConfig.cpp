@@ -4,6 +4,7 @@
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/stdout_sinks.h>
 #include <spdlog/sinks/rotating_file_sink.h>
+#include <spdlog/async.h>
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
 
@@ -20,6 +21,18 @@ spdlog::level::level_enum LoggerConfig::parseLevel(const std::string& levelStr)
     return spdlog::level::info;  // default
 }
 
+spdlog::async_overflow_policy LoggerConfig::parseOverflowPolicy(const std::string& policyStr) {
+    if (policyStr == "overrun-oldest") return spdlog::async_overflow_policy::overrun_oldest;
+    if (policyStr != "block") {
+        spdlog::warn("LoggerConfig: Unknown overflow policy '{}', using 'block'", policyStr);
+    }
+    return spdlog::async_overflow_policy::block;  // default
+}
+
+void LoggerConfig::Shutdown() {
+    spdlog::shutdown();
+}
+
 void LoggerConfig::ConfigureFromFile() {
     // Resolve config/logger_config.json relative to this source file
     std::filesystem::path sourcePath(__FILE__);
@@ -95,15 +108,29 @@ void LoggerConfig::ConfigureFromFile(const std::string& filename) {
             sinks.push_back(fallbackSink);
         }
 
-        auto logger = std::make_shared<spdlog::logger>(loggerName, sinks.begin(), sinks.end());
+        // Async logging moves formatting and sink I/O off the publish loop onto a worker thread
+        std::shared_ptr<spdlog::logger> logger;
+        std::string mode = "synchronous";
+        auto asyncConfig = loggerConfig.value("async", nlohmann::json::object());
+        if (asyncConfig.value("enabled", false)) {
+            size_t queueSize = asyncConfig.value("queue_size", 8192);
+            size_t threads = asyncConfig.value("threads", 1);
+            std::string policyStr = asyncConfig.value("overflow_policy", "block");
+            spdlog::init_thread_pool(queueSize, threads);
+            logger = std::make_shared<spdlog::async_logger>(loggerName, sinks.begin(), sinks.end(),
+                                                            spdlog::thread_pool(), parseOverflowPolicy(policyStr));
+            mode = "async (queue " + std::to_string(queueSize) + ", " + policyStr + " when full)";
+        } else {
+            logger = std::make_shared<spdlog::logger>(loggerName, sinks.begin(), sinks.end());
+        }
         logger->set_level(level);
         logger->set_pattern(pattern);
 
         spdlog::set_default_logger(logger);
         spdlog::set_level(level);              // ✅ Global filter level
-        spdlog::flush_on(spdlog::level::info);
+        spdlog::flush_on(parseLevel(loggerConfig.value("flush_on", "info")));
 
-        spdlog::info("LoggerConfig: Logger '{}' initialized with level '{}'", loggerName, levelStr);
+        spdlog::info("LoggerConfig: Logger '{}' initialized with level '{}', {}", loggerName, levelStr, mode);
     } catch (const std::exception& e) {
         spdlog::error("LoggerConfig: Exception caught during logger configuration: {}", e.what());
     }
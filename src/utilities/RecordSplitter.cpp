@@ -0,0 +1,47 @@
+#include "utilities/RecordSplitter.h"
+#include <algorithm>
+#include <stdexcept>
+
+RecordSplitter::RecordSplitter(std::string delimiter, size_t maxRecordBytes)
+    : delimiter_(std::move(delimiter)), maxRecordBytes_(std::max<size_t>(maxRecordBytes, 1)) {
+    if (delimiter_.empty()) {
+        throw std::invalid_argument("[RecordSplitter] The delimiter must not be empty.");
+    }
+}
+
+std::string& RecordSplitter::buffer() {
+    return pending_;
+}
+
+void RecordSplitter::split(std::vector<std::string>& out) {
+    size_t start = 0;
+    while (true) {
+        size_t end = pending_.find(delimiter_, start);
+        if (end == std::string::npos) {
+            break;
+        }
+        out.emplace_back(pending_, start, end - start);
+        start = end + delimiter_.size();
+    }
+    // A record that never ends is handed out in pieces rather than growing without bound
+    while (pending_.size() - start >= maxRecordBytes_) {
+        out.emplace_back(pending_, start, maxRecordBytes_);
+        start += maxRecordBytes_;
+    }
+    pending_.erase(0, start);
+}
+
+void RecordSplitter::flush(std::vector<std::string>& out) {
+    if (!pending_.empty()) {
+        out.push_back(std::move(pending_));
+        pending_.clear();
+    }
+}
+
+const std::string& RecordSplitter::getDelimiter() const {
+    return delimiter_;
+}
+
+size_t RecordSplitter::getMaxRecordBytes() const {
+    return maxRecordBytes_;
+}
@@ -4,6 +4,7 @@
 SignalHandler::SignalHandler() {
     // Initialize the flag indicating whether a quit signal is received
     quitSignalReceived.store(false);
+    dumpRequested.store(false);
 
     // Register signal handlers in the constructor
     registerSignalHandlers();
@@ -14,6 +15,7 @@ SignalHandler::~SignalHandler() {
     signal(SIGINT, SIG_DFL);
     signal(SIGHUP, SIG_DFL);
     signal(SIGTERM, SIG_DFL);
+    signal(SIGUSR1, SIG_DFL);
 }
 
 
@@ -22,18 +24,35 @@ void SignalHandler::registerSignalHandlers() {
     signal(SIGINT, handleQuitSignal);
     signal(SIGHUP, handleQuitSignal);
     signal(SIGTERM, handleQuitSignal);
+
+    // SIGUSR1 asks for a diagnostics dump without stopping
+    signal(SIGUSR1, handleDumpSignal);
 }
 
 bool SignalHandler::isQuitSignalReceived() const {
     return quitSignalReceived.load();
 }
 
+void SignalHandler::requestQuit() {
+    quitSignalReceived.store(true);
+}
+
+bool SignalHandler::consumeDumpRequest() {
+    return dumpRequested.exchange(false);
+}
+
 void SignalHandler::handleQuitSignal(int signal) {
     if (signal == SIGINT || signal == SIGHUP || signal == SIGTERM) {
         getInstance().quitSignalReceived.store(true);
     }
 }
 
+void SignalHandler::handleDumpSignal(int signal) {
+    if (signal == SIGUSR1) {
+        getInstance().dumpRequested.store(true);
+    }
+}
+
 SignalHandler& SignalHandler::getInstance() {
     static SignalHandler instance;
     return instance;